@@ -5,28 +5,14 @@
 #include <cmath>
 #include <random>
 #include <ctime>
+#include <string>
+#include <chrono>
+#include <iomanip>
 #include <SFML/Graphics.hpp>
+#include "hull.h"
 
 using namespace std;
 
-// 点的结构体
-struct Point {
-    double x, y;
-
-    Point(double x = 0, double y = 0) : x(x), y(y) {}
-
-    // 重载运算符便于比较
-    bool operator==(const Point& other) const {
-        return x == other.x && y == other.y;
-    }
-
-    // 用于输出点
-    friend ostream& operator<<(ostream& os, const Point& p) {
-        os << "(" << p.x << ", " << p.y << ")";
-        return os;
-    }
-};
-
 // 生成随机点集
 vector<Point> generateRandomPoints(int numPoints, double minX = 0, double maxX = 100,
     double minY = 0, double maxY = 100) {
@@ -58,67 +44,18 @@ vector<Point> generateRandomPoints(int numPoints, double minX = 0, double maxX =
     return uniquePoints;
 }
 
-// 计算叉积 (P1P2) × (P1P3)
-double crossProduct(const Point& p1, const Point& p2, const Point& p3) {
-    return (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
-}
-
-// 计算两点间距离的平方
-double distanceSquared(const Point& p1, const Point& p2) {
-    double dx = p2.x - p1.x;
-    double dy = p2.y - p1.y;
-    return dx * dx + dy * dy;
-}
-
-// 卷包裹法（Gift Wrapping Algorithm）计算凸包
-vector<Point> giftWrapping(vector<Point>& points) {
-    int n = points.size();
-    if (n < 3) {
-        return points; // 点太少，直接返回
-    }
+// 生成分布在圆周上的点集，大部分点都是凸包点，是卷包裹法的最坏情况
+vector<Point> generateCirclePoints(int numPoints, double centerX = 50, double centerY = 50, double radius = 50) {
+    vector<Point> points;
+    random_device rd;
+    mt19937 gen(rd());
+    uniform_real_distribution<double> distAngle(0, 2 * 3.14159265358979323846);
 
-    // 找到最左边的点（y坐标最小的，如果x相同）
-    int leftmost = 0;
-    for (int i = 1; i < n; i++) {
-        if (points[i].x < points[leftmost].x ||
-            (points[i].x == points[leftmost].x && points[i].y < points[leftmost].y)) {
-            leftmost = i;
-        }
+    for (int i = 0; i < numPoints; i++) {
+        double angle = distAngle(gen);
+        points.push_back(Point(centerX + radius * cos(angle), centerY + radius * sin(angle)));
     }
-
-    vector<Point> hull; // 凸包点集
-
-    int p = leftmost; // 当前凸包点
-    int q; // 下一个候选点
-
-    do {
-        hull.push_back(points[p]);
-
-        q = (p + 1) % n; // 初始候选点
-
-        // 寻找下一个凸包点
-        for (int i = 0; i < n; i++) {
-            if (i == p || i == q) continue;
-
-            double cross = crossProduct(points[p], points[i], points[q]);
-
-            if (cross > 0) {
-                // 更新候选点
-                q = i;
-            }
-            else if (cross == 0) {
-                // 共线情况，选择距离更远的点
-                if (distanceSquared(points[p], points[i]) > distanceSquared(points[p], points[q])) {
-                    q = i;
-                }
-            }
-        }
-
-        p = q; // 移动到下一个点
-
-    } while (p != leftmost && hull.size() <= n); // 回到起点时结束
-
-    return hull;
+    return points;
 }
 
 // 显示点集信息
@@ -275,24 +212,178 @@ void visualizeConvexHull(const vector<Point>& points, const vector<Point>& hull,
     }
 }
 
-int main() {
+// 并行凸包的扩展性测试：线程数从 1 开始每次翻倍直到 maxThreads，每个线程数取 3 次运行的中位数
+void runScalingBenchmark(const vector<Point>& points, unsigned maxThreads) {
+    auto timeOnce = [&points](ThreadPool& pool) {
+        auto startTime = chrono::high_resolution_clock::now();
+        auto hull = parallelHull(points, pool);
+        auto endTime = chrono::high_resolution_clock::now();
+        return chrono::duration<double, milli>(endTime - startTime).count();
+    };
+
+    auto startTime = chrono::high_resolution_clock::now();
+    computeHull(points);
+    auto endTime = chrono::high_resolution_clock::now();
+    double serial = chrono::duration<double, milli>(endTime - startTime).count();
+
+    cout << "Parallel hull scaling (" << points.size() << " points, serial auto " << fixed << setprecision(3) << serial << " ms)" << endl;
+    cout << setw(8) << "threads" << setw(14) << "time(ms)" << setw(10) << "speedup" << setw(12) << "efficiency" << endl;
+
+    double base = 0;
+    vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+    for (unsigned t : threadCounts) {
+        ThreadPool pool(t);
+        timeOnce(pool); // 预热：线程启动、内存分配
+        double times[3];
+        for (double& time : times) time = timeOnce(pool);
+        sort(times, times + 3);
+        if (t == 1) base = times[1];
+        cout << setw(8) << t << setw(14) << setprecision(3) << times[1] << setw(10) << setprecision(2) << base / times[1]
+            << setw(12) << base / times[1] / t << endl;
+    }
+    cout << defaultfloat << setprecision(6) << endl;
+}
+
+// 命令行用法
+void printUsage(const char* program) {
+    cout << "Usage: " << program << " [-a gift|monotone|chan|parallel|auto|all] [-n numPoints] [-d uniform|circle] [-t threads] [--cull] [--scaling] [--no-window]" << endl;
+    cout << "  -a  hull algorithm, auto picks a serial one from n and the estimated hull size, all runs and times every algorithm" << endl;
+    cout << "  -t  worker threads for the parallel algorithm (default: hardware threads)" << endl;
+    cout << "  --scaling  time the parallel algorithm with 1, 2, 4, ... up to -t threads" << endl;
+    cout << "  -n  number of random points (default 20)" << endl;
+    cout << "  -d  point distribution (default uniform)" << endl;
+    cout << "  --cull  drop points inside the extreme-point octagon (Akl-Toussaint) before running the hull" << endl;
+}
+
+int main(int argc, char* argv[]) {
     // 设置随机种子
     srand(time(nullptr));
 
-    cout << "2D Convex Hull Calculator - Gift Wrapping Algorithm" << endl;
+    HullAlgorithm algorithm = HullAlgorithm::Auto;
+    bool runAll = false;
+    int numPoints = 20;
+    string distribution = "uniform";
+    bool showWindow = true;
+    bool cull = false;
+    bool scaling = false;
+    unsigned threads = ThreadPool::defaultThreadCount();
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if ((arg == "-a" || arg == "--algorithm") && i + 1 < argc) {
+            string name = argv[++i];
+            runAll = name == "all";
+            if (!runAll && !parseHullAlgorithm(name, algorithm)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if ((arg == "-n" || arg == "--points") && i + 1 < argc) {
+            numPoints = atoi(argv[++i]);
+        }
+        else if ((arg == "-d" || arg == "--distribution") && i + 1 < argc) {
+            distribution = argv[++i];
+        }
+        else if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+            threads = (unsigned)max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--scaling") {
+            scaling = true;
+        }
+        else if (arg == "--cull") {
+            cull = true;
+        }
+        else if (arg == "--no-window") {
+            showWindow = false;
+        }
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (numPoints <= 0 || (distribution != "uniform" && distribution != "circle")) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    cout << "2D Convex Hull Calculator" << endl;
     cout << string(50, '=') << endl;
 
-    cout << "Random Point Set" << endl;
-    auto randomPoints = generateRandomPoints(20, 0, 100, 0, 100);
-    displayPoints(randomPoints, "Random Points");
+    cout << "Random Point Set (" << distribution << ")" << endl;
+    auto randomPoints = distribution == "circle" ? generateCirclePoints(numPoints) : generateRandomPoints(numPoints, 0, 100, 0, 100);
+    if (randomPoints.size() <= 100) {
+        displayPoints(randomPoints, "Random Points");
+    }
+    else {
+        cout << randomPoints.size() << " points generated\n" << endl;
+    }
+
+    // Akl–Toussaint 预处理，之后的算法只处理保留下来的点
+    vector<Point> hullInput;
+    if (cull) {
+        size_t removed = 0;
+        auto startTime = chrono::high_resolution_clock::now();
+        hullInput = aklToussaintCull(randomPoints, removed);
+        auto endTime = chrono::high_resolution_clock::now();
+        cout << "Akl-Toussaint culling removed " << removed << " of " << randomPoints.size() << " points ("
+            << fixed << setprecision(1) << 100.0 * removed / randomPoints.size() << "%) in " << setprecision(3)
+            << chrono::duration<double, milli>(endTime - startTime).count() << " ms" << endl;
+    }
+    else {
+        hullInput = randomPoints;
+    }
+
+    vector<HullAlgorithm> algorithms;
+    if (runAll) {
+        algorithms = { HullAlgorithm::GiftWrapping, HullAlgorithm::MonotoneChain, HullAlgorithm::Chan, HullAlgorithm::Parallel };
+    }
+    else if (algorithm == HullAlgorithm::Auto) {
+        algorithm = selectHullAlgorithm(hullInput);
+        cout << "Selected algorithm: " << hullAlgorithmName(algorithm)
+            << " (estimated hull size " << estimateHullSize(hullInput) << ")" << endl;
+        algorithms = { algorithm };
+    }
+    else {
+        algorithms = { algorithm };
+    }
+
+    // 依次运行并计时，多个算法的结果应完全一致
+    ThreadPool pool(threads);
+    vector<Point> randomHull;
+    for (size_t i = 0; i < algorithms.size(); i++) {
+        auto startTime = chrono::high_resolution_clock::now();
+        auto hull = computeHull(hullInput, algorithms[i], false, &pool);
+        auto endTime = chrono::high_resolution_clock::now();
+
+        cout << setw(10) << hullAlgorithmName(algorithms[i]) << ": " << fixed << setprecision(3)
+            << chrono::duration<double, milli>(endTime - startTime).count() << " ms, "
+            << hull.size() << " hull points";
+        if (i > 0 && !(hull == randomHull)) {
+            cout << "  (result differs from " << hullAlgorithmName(algorithms[0]) << ")";
+        }
+        cout << endl;
+        if (i == 0) {
+            randomHull = hull;
+        }
+    }
+    cout << defaultfloat << setprecision(6) << endl; // 恢复默认格式，后面输出点坐标
+
+    if (scaling) {
+        runScalingBenchmark(hullInput, threads);
+    }
 
-    auto randomHull = giftWrapping(randomPoints);
-    displayConvexHull(randomHull);
+    if (randomHull.size() <= 100) {
+        displayConvexHull(randomHull);
+    }
 
-    // 可视化凸包
-    cout << "Opening visualization window..." << endl;
-    cout << "Press ESC or close the window to return to console" << endl;
-    visualizeConvexHull(randomPoints, randomHull, "Convex Hull Visualization - Gift Wrapping");
+    // 可视化凸包，点数太多时窗口绘制很慢，跳过
+    if (showWindow && randomPoints.size() <= 5000) {
+        cout << "Opening visualization window..." << endl;
+        cout << "Press ESC or close the window to return to console" << endl;
+        visualizeConvexHull(randomPoints, randomHull, string("Convex Hull Visualization - ") + hullAlgorithmName(algorithms[0]));
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,427 @@
+﻿#pragma once
+#ifndef H_HULL
+#define H_HULL
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include "predicates.h"
+#include "thread_pool.h"
+
+// 点的结构体
+struct Point {
+    double x, y;
+
+    Point(double x = 0, double y = 0) : x(x), y(y) {}
+
+    // 重载运算符便于比较
+    bool operator==(const Point& other) const {
+        return x == other.x && y == other.y;
+    }
+
+    // 用于输出点
+    friend std::ostream& operator<<(std::ostream& os, const Point& p) {
+        os << "(" << p.x << ", " << p.y << ")";
+        return os;
+    }
+};
+
+// 计算叉积 (P1P2) × (P1P3)，使用自适应精度谓词，共线判断 (== 0) 是精确的
+inline double crossProduct(const Point& p1, const Point& p2, const Point& p3) {
+    return predicates::orient2d(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y);
+}
+
+// 计算两点间距离的平方
+inline double distanceSquared(const Point& p1, const Point& p2) {
+    double dx = p2.x - p1.x;
+    double dy = p2.y - p1.y;
+    return dx * dx + dy * dy;
+}
+
+// 按 x 再按 y 排序的比较函数，最小的点就是卷包裹法的起点
+inline bool lexicographicLess(const Point& a, const Point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// 从 p 出发时，a 是否比 b 更适合作为下一个凸包点：b 在有向线段 pa 左侧，或三点共线但 a 更远。
+// 与 p 重合的点永远不会被选中
+inline bool betterNextHullPoint(const Point& p, const Point& a, const Point& b) {
+    if (a == p) return false;
+    if (b == p) return true;
+    double cross = crossProduct(p, a, b);
+    return cross > 0 || (cross == 0 && distanceSquared(p, a) > distanceSquared(p, b));
+}
+
+// 以下各算法的输出一致：从最左（x 相同取 y 最小）的点开始按逆时针排列，不含共线的中间点；
+// 少于 3 个点时原样返回
+
+// 卷包裹法（Gift Wrapping Algorithm）计算凸包，O(nh)
+inline std::vector<Point> giftWrapping(const std::vector<Point>& points) {
+    int n = points.size();
+    if (n < 3) {
+        return points; // 点太少，直接返回
+    }
+
+    // 找到最左边的点（y坐标最小的，如果x相同）
+    int leftmost = 0;
+    for (int i = 1; i < n; i++) {
+        if (lexicographicLess(points[i], points[leftmost])) {
+            leftmost = i;
+        }
+    }
+
+    std::vector<Point> hull; // 凸包点集
+
+    int p = leftmost; // 当前凸包点
+    int q; // 下一个候选点
+
+    do {
+        hull.push_back(points[p]);
+
+        q = (p + 1) % n; // 初始候选点
+
+        // 寻找下一个凸包点：叉积为正时更新候选点，共线时选择距离更远的点
+        for (int i = 0; i < n; i++) {
+            if (i == p || i == q) continue;
+
+            if (betterNextHullPoint(points[p], points[i], points[q])) {
+                q = i;
+            }
+        }
+
+        p = q; // 移动到下一个点
+
+    } while (!(points[p] == points[leftmost]) && hull.size() <= (size_t)n); // 回到起点（按坐标比较，起点可能有重复点）时结束
+
+    return hull;
+}
+
+// 对 [first, last) 中已按 lexicographicLess 排好序的点求凸包（Andrew 单调链），O(n)，结果追加到 hull 末尾
+inline void monotoneChainSorted(const Point* first, const Point* last, std::vector<Point>& hull) {
+    const size_t base = hull.size();
+    const size_t n = last - first;
+
+    // 下凸壳：从左到右，去掉不构成左转的点
+    for (size_t i = 0; i < n; i++) {
+        while (hull.size() >= base + 2 && crossProduct(hull[hull.size() - 2], hull.back(), first[i]) <= 0) hull.pop_back();
+        hull.push_back(first[i]);
+    }
+    // 上凸壳：从右到左
+    const size_t lower = hull.size() + 1;
+    for (size_t i = n - 1; i > 0; i--) {
+        while (hull.size() >= lower && crossProduct(hull[hull.size() - 2], hull.back(), first[i - 1]) <= 0) hull.pop_back();
+        hull.push_back(first[i - 1]);
+    }
+
+    // 最后一个点与起点重合
+    if (hull.size() > base + 1) hull.pop_back();
+    // 所有点重合时上下凸壳各留下一份同一个点，只保留一个，与其他算法一致
+    if (hull.size() == base + 2 && hull[base] == hull[base + 1]) hull.pop_back();
+}
+
+// Andrew 单调链算法，O(n log n)
+inline std::vector<Point> monotoneChain(const std::vector<Point>& points) {
+    if (points.size() < 3) {
+        return points;
+    }
+    std::vector<Point> sorted(points);
+    std::sort(sorted.begin(), sorted.end(), lexicographicLess);
+
+    std::vector<Point> hull;
+    hull.reserve(2 * sorted.size());
+    monotoneChainSorted(sorted.data(), sorted.data() + sorted.size(), hull);
+    return hull;
+}
+
+// 在凸多边形 [first, first + k)（逆时针）上找出从 p 看去最适合作为下一个凸包点的顶点。
+// 从上次的结果 start 出发沿两个方向爬升：p 在多边形外或是其顶点时，候选的优劣沿边界是单峰的
+inline size_t hullTangent(const Point* polygon, size_t k, const Point& p, size_t start) {
+    size_t i = start;
+    while (betterNextHullPoint(p, polygon[(i + 1) % k], polygon[i])) i = (i + 1) % k;
+    while (betterNextHullPoint(p, polygon[(i + k - 1) % k], polygon[i])) i = (i + k - 1) % k;
+    return i;
+}
+
+// Chan 算法，输出敏感的 O(n log h)：猜测凸包大小 m（默认从 4 开始），把点分成大小为 m 的组，
+// 每组用单调链求凸包，再在各组凸包上做最多 m 步卷包裹；没能闭合就把 m 平方后重来。
+// 各组凸包以外的点不可能是凸包点，下一轮只保留各组凸包的顶点；
+// 每一步中各组的切点由上一步的切点爬升得到，而不是重新二分查找。
+// 给出较准确的初始猜测（如 estimateHullSize 的两倍）可以省掉前几轮注定失败的计算
+inline std::vector<Point> chan(const std::vector<Point>& points, size_t initialGuess = 4) {
+    size_t n = points.size();
+    if (n < 3) {
+        return points;
+    }
+
+    size_t leftmost = 0;
+    for (size_t i = 1; i < n; i++) {
+        if (lexicographicLess(points[i], points[leftmost])) leftmost = i;
+    }
+    const Point start = points[leftmost];
+
+    std::vector<Point> work(points);
+    std::vector<Point> groupHulls;        // 各组凸包依次存放
+    std::vector<size_t> groupOffsets;     // 第 g 组凸包为 [groupOffsets[g], groupOffsets[g + 1])
+    std::vector<size_t> tangent;
+    std::vector<Point> hull;
+
+    for (size_t m = std::min(std::max<size_t>(initialGuess, 4), n);; m = (m >= n / m) ? n : m * m) {
+        groupHulls.clear();
+        groupOffsets.assign(1, 0);
+        for (size_t first = 0; first < work.size(); first += m) {
+            Point* begin = work.data() + first;
+            Point* end = work.data() + std::min(work.size(), first + m);
+            std::sort(begin, end, lexicographicLess);
+            monotoneChainSorted(begin, end, groupHulls);
+            groupOffsets.push_back(groupHulls.size());
+        }
+        size_t groupCount = groupOffsets.size() - 1;
+        tangent.assign(groupCount, 0);
+
+        hull.clear();
+        Point p = start;
+        for (size_t step = 0; step < m; step++) {
+            hull.push_back(p);
+
+            // 每组取最好的候选点，再在各组之间比较
+            Point q = groupHulls[0];
+            for (size_t g = 0; g < groupCount; g++) {
+                const Point* polygon = groupHulls.data() + groupOffsets[g];
+                tangent[g] = hullTangent(polygon, groupOffsets[g + 1] - groupOffsets[g], p, tangent[g]);
+                if (g == 0 || betterNextHullPoint(p, polygon[tangent[g]], q)) {
+                    q = polygon[tangent[g]];
+                }
+            }
+
+            if (q == start) return hull;
+            p = q;
+        }
+
+        work.swap(groupHulls);
+    }
+}
+
+// Akl–Toussaint 预处理：去掉严格位于极值点多边形内部的点，这些点不可能是凸包点。
+// 只用 x、y 的四个极值点时，均匀分布在正方形中的点只能去掉约一半，所以再加上 x + y、x - y 方向的
+// 四个极值点，得到按逆时针排列的八边形。每个点只做八次无分支的定向判断，判断只用带误差界的快速路径，
+// 无法确定时保留该点，所以不会误删凸包点。返回保留的点（保持原顺序），removed 为去掉的点数
+inline std::vector<Point> aklToussaintCull(const std::vector<Point>& points, size_t& removed) {
+    removed = 0;
+    size_t n = points.size();
+    if (n < 4) {
+        return points;
+    }
+
+    // 方向依次为 左、左下、下、右下、右、右上、上、左上，对应的极值点按逆时针排列
+    const double dirX[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+    const double dirY[8] = { 0, -1, -1, -1, 0, 1, 1, 1 };
+    size_t extreme[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    double best[8];
+    for (int e = 0; e < 8; e++) {
+        best[e] = dirX[e] * points[0].x + dirY[e] * points[0].y;
+    }
+    for (size_t i = 1; i < n; i++) {
+        for (int e = 0; e < 8; e++) {
+            double d = dirX[e] * points[i].x + dirY[e] * points[i].y;
+            if (d > best[e]) {
+                best[e] = d;
+                extreme[e] = i;
+            }
+        }
+    }
+
+    // 去掉相邻的重合顶点，不足三个顶点时多边形退化，没有点严格在内部
+    Point polygon[8];
+    int k = 0;
+    for (int e = 0; e < 8; e++) {
+        const Point& v = points[extreme[e]];
+        if (k == 0 || !(v == polygon[k - 1])) polygon[k++] = v;
+    }
+    while (k > 1 && polygon[k - 1] == polygon[0]) k--;
+    if (k < 3) {
+        return points;
+    }
+
+    // 八条边 (a, b)，顶点不足八个时用第一条边补齐
+    double ax[8], ay[8], bx[8], by[8];
+    for (int e = 0; e < 8; e++) {
+        int i = e < k ? e : 0;
+        ax[e] = polygon[i].x;
+        ay[e] = polygon[i].y;
+        bx[e] = polygon[(i + 1) % k].x;
+        by[e] = polygon[(i + 1) % k].y;
+    }
+
+    std::vector<Point> kept(n);
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        const Point& p = points[i];
+        bool inside = true;
+        for (int e = 0; e < 8; e++) {
+            inside &= predicates::orient2dCertainlyPositive(ax[e], ay[e], bx[e], by[e], p.x, p.y);
+        }
+        // 无分支的压缩：总是写入，只有保留时才前进
+        kept[count] = p;
+        count += !inside;
+    }
+    kept.resize(count);
+    removed = n - count;
+    return kept;
+}
+
+// 可选的凸包算法
+enum class HullAlgorithm {
+    Auto,
+    GiftWrapping,
+    MonotoneChain,
+    Chan,
+    Parallel
+};
+
+inline const char* hullAlgorithmName(HullAlgorithm algorithm) {
+    switch (algorithm) {
+    case HullAlgorithm::GiftWrapping: return "gift";
+    case HullAlgorithm::MonotoneChain: return "monotone";
+    case HullAlgorithm::Chan: return "chan";
+    case HullAlgorithm::Parallel: return "parallel";
+    default: return "auto";
+    }
+}
+
+// 由命令行参数解析算法名，不认识时返回 false
+inline bool parseHullAlgorithm(const std::string& name, HullAlgorithm& algorithm) {
+    const HullAlgorithm all[] = { HullAlgorithm::Auto, HullAlgorithm::GiftWrapping,
+        HullAlgorithm::MonotoneChain, HullAlgorithm::Chan, HullAlgorithm::Parallel };
+    for (HullAlgorithm a : all) {
+        if (name == hullAlgorithmName(a)) {
+            algorithm = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 用等间隔抽取的样本估计凸包点数：样本中凸包点占比高（点分布在圆周上）时按比例外推，
+// 否则按均匀分布的 O(log n) 增长外推
+inline size_t estimateHullSize(const std::vector<Point>& points, size_t sampleSize = 1024) {
+    size_t n = points.size();
+    if (n <= sampleSize) {
+        return monotoneChain(points).size();
+    }
+
+    std::vector<Point> sample;
+    sample.reserve(sampleSize);
+    for (size_t i = 0; i < sampleSize; i++) {
+        sample.push_back(points[i * n / sampleSize]);
+    }
+    double h = (double)monotoneChain(sample).size();
+    double ratio = h / sampleSize;
+    if (ratio > 0.25) {
+        return (size_t)(ratio * n);
+    }
+    return (size_t)(h * std::log((double)n) / std::log((double)sampleSize)) + 1;
+}
+
+// 根据点数和估计的凸包点数选择代价最小的算法。各项系数由 Release 下的实测耗时粗略拟合：
+// 卷包裹每点每步约 1 个单位，单调链排序约每点 log2(n) 个单位，Chan 约每点 3 log2(h) 个单位
+inline HullAlgorithm selectHullAlgorithm(const std::vector<Point>& points) {
+    size_t n = points.size();
+    if (n < 64) {
+        return HullAlgorithm::GiftWrapping;
+    }
+    double h = (double)std::max<size_t>(estimateHullSize(points), 3);
+    double giftCost = n * h;
+    double monotoneCost = n * std::log2((double)n);
+    double chanCost = 3.0 * n * std::log2(h);
+    if (giftCost <= monotoneCost && giftCost <= chanCost) return HullAlgorithm::GiftWrapping;
+    return chanCost < monotoneCost ? HullAlgorithm::Chan : HullAlgorithm::MonotoneChain;
+}
+
+inline std::vector<Point> parallelHull(const std::vector<Point>& points, ThreadPool& pool, size_t chunksPerThread = 4);
+
+// 统一的凸包入口，Auto 时按 selectHullAlgorithm 选择（只在串行算法中选择）；cull 为 true 时先做 Akl–Toussaint 预处理。
+// Parallel 使用 pool，没有给出时临时创建一个使用全部硬件线程的线程池
+inline std::vector<Point> computeHull(const std::vector<Point>& points, HullAlgorithm algorithm = HullAlgorithm::Auto,
+    bool cull = false, ThreadPool* pool = nullptr) {
+    if (cull) {
+        size_t removed;
+        return computeHull(aklToussaintCull(points, removed), algorithm, false, pool);
+    }
+    if (algorithm == HullAlgorithm::Parallel) {
+        if (pool) {
+            return parallelHull(points, *pool);
+        }
+        ThreadPool localPool;
+        return parallelHull(points, localPool);
+    }
+    if (algorithm == HullAlgorithm::Auto) {
+        algorithm = selectHullAlgorithm(points);
+    }
+    switch (algorithm) {
+    case HullAlgorithm::GiftWrapping: return giftWrapping(points);
+    case HullAlgorithm::Chan: return chan(points, 2 * estimateHullSize(points));
+    default: return monotoneChain(points);
+    }
+}
+
+// 把凸包（从最左点开始逆时针）的顶点按 lexicographicLess 排好序：
+// 从起点到字典序最大点的下凸链本身有序，其余的上凸链倒过来有序，二者归并即可，O(h)
+inline std::vector<Point> sortedHullVertices(const std::vector<Point>& hull) {
+    size_t right = 0;
+    for (size_t i = 1; i < hull.size(); i++) {
+        if (lexicographicLess(hull[right], hull[i])) right = i;
+    }
+    std::vector<Point> sorted(hull.size());
+    if (!hull.empty()) {
+        std::merge(hull.begin(), hull.begin() + right + 1, hull.rbegin(), hull.rend() - right - 1,
+            sorted.begin(), lexicographicLess);
+    }
+    return sorted;
+}
+
+// 并行分治凸包：把点分成若干连续的块（块数为线程数的 chunksPerThread 倍，快的线程可以窃取剩下的块），
+// 各块在线程池上用 Auto 选出的串行算法求子凸包，子凸包顶点排好序后在线程池上两两归并，
+// 最后对归并结果做一遍单调链。输出与串行算法一致
+inline std::vector<Point> parallelHull(const std::vector<Point>& points, ThreadPool& pool, size_t chunksPerThread) {
+    size_t n = points.size();
+    if (n < 3) {
+        return points;
+    }
+
+    const size_t minChunk = 1024;
+    size_t chunks = std::max<size_t>(1, std::min<size_t>(pool.size() * chunksPerThread, n / minChunk));
+    std::vector<std::vector<Point>> parts(chunks);
+
+    TaskGroup group(pool);
+    for (size_t c = 0; c < chunks; c++) {
+        group.run([&points, &parts, n, chunks, c] {
+            std::vector<Point> chunk(points.begin() + n * c / chunks, points.begin() + n * (c + 1) / chunks);
+            parts[c] = sortedHullVertices(computeHull(chunk));
+        });
+    }
+    group.wait();
+
+    // 两两归并，每一层的归并互相独立
+    for (size_t width = 1; width < chunks; width *= 2) {
+        for (size_t c = 0; c + width < chunks; c += 2 * width) {
+            group.run([&parts, c, width] {
+                std::vector<Point> merged(parts[c].size() + parts[c + width].size());
+                std::merge(parts[c].begin(), parts[c].end(), parts[c + width].begin(), parts[c + width].end(),
+                    merged.begin(), lexicographicLess);
+                parts[c].swap(merged);
+                std::vector<Point>().swap(parts[c + width]);
+            });
+        }
+        group.wait();
+    }
+
+    std::vector<Point> hull;
+    hull.reserve(2 * parts[0].size());
+    monotoneChainSorted(parts[0].data(), parts[0].data() + parts[0].size(), hull);
+    return hull;
+}
+
+#endif
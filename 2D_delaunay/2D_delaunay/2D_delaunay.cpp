@@ -8,9 +8,18 @@
 #include "delaunay.h"
 #include "io.h"
 #include "visualize.h"
+#include "benchmark.h"
+#include "streaming.h"
+#include "point_file.h"
+#include "mesh_file.h"
+#include "statistics.h"
+#include "batch.h"
+#include "bench_harness.h"
 
 // 处理单个文件
-void processFile(int fileNum, bool saveResults = true) {
+// binaryOutput 为 true 时结果写成二进制网格文件 mesh.bin，代替 edges.txt / triangles.txt；
+// 保存结果时统计信息加入 stats，由调用方在全部文件处理完后统一写出
+void processFile(int fileNum, StatisticsAggregator& stats, bool saveResults = true, bool binaryOutput = false) {
     std::cout << "\n=== 处理文件 " << fileNum << " ===" << std::endl;
 
     // 构建文件路径
@@ -44,22 +53,33 @@ void processFile(int fileNum, bool saveResults = true) {
         }
     }
 
-    // 计时开始
-    auto startTime = std::chrono::high_resolution_clock::now();
-
     // 进行Delaunay三角剖分
+    // 二进制输出只需要索引网格，不再生成 Triangle / Edge 对象。计时只包含剖分本身，
+    // 单次计时的精度有限，需要可靠的耗时数据时使用基准测试（菜单选项9）
     std::cout << "开始三角剖分..." << std::endl;
     Delaunay<float> triangulation;
-    const std::vector<Triangle<float>> triangles = triangulation.triangulate(points);
-    const std::vector<Edge<float>> edges = triangulation.getEdges();
+    auto startTime = std::chrono::steady_clock::now();
+    if (binaryOutput) {
+        triangulation.triangulateIndexed(points);
+    }
+    else {
+        triangulation.triangulate(points);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    const long long duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
 
-    // 计时结束
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    const std::vector<Triangle<float>>& triangles = triangulation.getTriangles();
+    // 每条边只计一次；二进制输出不生成 Edge 对象，由索引网格的邻接关系直接数出
+    const std::size_t triangleCount = binaryOutput ? triangulation.getMesh().triangleCount() : triangles.size();
+    const std::size_t edgeCount = binaryOutput ? triangulation.getMesh().edgeCount() : triangulation.getEdges().size();
 
-    std::cout << "生成 " << triangles.size() << " 个三角形" << std::endl;
-    std::cout << "生成 " << edges.size() << " 条边" << std::endl;
-    std::cout << "计算耗时: " << duration.count() << " 毫秒" << std::endl;
+    std::cout << "生成 " << triangleCount << " 个三角形" << std::endl;
+    std::cout << "生成 " << edgeCount << " 条边" << std::endl;
+    std::cout << "计算耗时: " << duration / 1000 << " 微秒" << std::endl;
+
+    // 凸包由剖分的边界直接得到，按逆时针顺序排列
+    const std::vector<std::uint32_t>& hull = triangulation.buildConvexHull();
+    std::cout << "凸包顶点数: " << hull.size() << std::endl;
 
     if (saveResults) {
         // 保存结果数据
@@ -67,27 +87,45 @@ void processFile(int fileNum, bool saveResults = true) {
             std::cerr << "保存处理后的点数据失败" << std::endl;
         }
 
-        if (!FileIO::saveEdgesToFile(edges, resultDir + "edges.txt")) {
-            std::cerr << "保存边数据失败" << std::endl;
+        std::vector<Vector2<float>> hullPoints;
+        hullPoints.reserve(hull.size());
+        for (std::uint32_t v : hull) hullPoints.push_back(points[v]);
+        if (!FileIO::savePointsToFile(hullPoints, resultDir + "hull.txt")) {
+            std::cerr << "保存凸包数据失败" << std::endl;
         }
 
-        if (!FileIO::saveTrianglesToFile(triangles, resultDir + "triangles.txt")) {
-            std::cerr << "保存三角形数据失败" << std::endl;
+        if (binaryOutput) {
+            // 顶点表 + 三角形编号，边可由三角形恢复
+            if (!saveMeshFile(triangulation.getMesh(), resultDir + "mesh.bin")) {
+                std::cerr << "保存网格数据失败" << std::endl;
+            }
         }
+        else {
+            if (!FileIO::saveEdgesToFile(triangulation.getEdges(), resultDir + "edges.txt")) {
+                std::cerr << "保存边数据失败" << std::endl;
+            }
 
-        // 保存统计信息
-        if (!FileIO::saveStatisticsToFile(fileNum, points.size(), triangles.size(), edges.size(),
-            duration.count(), "../result/statistics.csv")) {
-            std::cerr << "保存统计信息失败" << std::endl;
+            if (!FileIO::saveTrianglesToFile(triangles, resultDir + "triangles.txt")) {
+                std::cerr << "保存三角形数据失败" << std::endl;
+            }
         }
+
+        // 记录统计信息
+        FileStatistics record;
+        record.name = std::to_string(fileNum);
+        record.pointCount = points.size();
+        record.triangleCount = triangleCount;
+        record.edgeCount = edgeCount;
+        record.duration = duration;
+        stats.add(record);
     }
 
     // 输出统计信息
     std::cout << "文件 " << fileNum << " 处理完成:" << std::endl;
     std::cout << "  - 点数: " << points.size() << std::endl;
-    std::cout << "  - 三角形数: " << triangles.size() << std::endl;
-    std::cout << "  - 边数: " << edges.size() << std::endl;
-    std::cout << "  - 计算耗时: " << duration.count() << " 毫秒" << std::endl;
+    std::cout << "  - 三角形数: " << triangleCount << std::endl;
+    std::cout << "  - 边数: " << edgeCount << std::endl;
+    std::cout << "  - 计算耗时: " << duration / 1000 << " 微秒" << std::endl;
 
     if (saveResults) {
         std::cout << "  - 结果保存到: " << resultDir << std::endl;
@@ -147,6 +185,49 @@ void processRandomExample() {
     std::cout << "  - 计算耗时: " << duration.count() << " 毫秒" << std::endl;
 }
 
+// 对大于内存的点文件做流式剖分，结果直接写入三角形文件
+void processStreamingFile() {
+    std::cout << "\n=== 流式剖分大文件 ===" << std::endl;
+    std::cout << "点文件应按 x 坐标排序或按块组织（每行 \"x y\"），否则驻留内存不会减少" << std::endl;
+
+    std::string input, output;
+    std::cout << "请输入点文件路径: ";
+    std::cin >> input;
+    std::cout << "请输入三角形输出路径: ";
+    std::cin >> output;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    StreamingStats stats;
+    if (!StreamingDelaunay<float>::triangulateFile(input, output, &stats)) {
+        std::cerr << "流式剖分失败" << std::endl;
+        return;
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+    std::cout << "流式剖分完成:" << std::endl;
+    std::cout << "  - 点数: " << stats.points << std::endl;
+    std::cout << "  - 三角形数: " << stats.triangles << std::endl;
+    std::cout << "  - 驻留三角形峰值: " << stats.peakFaces << std::endl;
+    std::cout << "  - 驻留顶点峰值: " << stats.peakVertices << std::endl;
+    std::cout << "  - 计算耗时: " << duration.count() << " 毫秒" << std::endl;
+    std::cout << "  - 结果保存到: " << output << std::endl;
+}
+
+// 把 data 目录下的 1-10 号文本点文件转换为二进制点文件（N.bin），之后可直接内存映射读取
+void convertDataFiles() {
+    std::cout << "\n=== 转换为二进制点文件 ===" << std::endl;
+    const std::string dataDir = FileIO::pathExists("../data") ? "../data/" : "./data/";
+    for (int i = 1; i <= 10; ++i) {
+        const std::string textFile = dataDir + std::to_string(i) + ".txt";
+        if (!FileIO::pathExists(textFile)) {
+            std::cout << "数据文件不存在: " << textFile << "，跳过" << std::endl;
+            continue;
+        }
+        convertPointFile<float>(textFile, dataDir + std::to_string(i) + ".bin");
+    }
+}
+
 // 显示菜单
 void showMenu() {
     std::cout << "\n==========================================" << std::endl;
@@ -156,11 +237,35 @@ void showMenu() {
     std::cout << "1. 处理10个文件（无可视化，只保存数据）" << std::endl;
     std::cout << "2. 随机生成例子并可视化" << std::endl;
     std::cout << "3. 重新生成1-10的数据文件" << std::endl;
+    std::cout << "4. 大规模点集性能测试" << std::endl;
+    std::cout << "5. 并行剖分强扩展性测试（10^6 与 10^7 个点）" << std::endl;
+    std::cout << "6. 流式剖分大文件（结果直接写入文件）" << std::endl;
+    std::cout << "7. 将1-10的数据文件转换为二进制点文件" << std::endl;
+    std::cout << "8. 处理10个文件（结果保存为二进制网格文件）" << std::endl;
+    std::cout << "9. 基准测试（预热、重复计时、分阶段耗时，结果写入 result/benchmark.csv）" << std::endl;
     std::cout << "0. 退出程序" << std::endl;
-    std::cout << "请输入选择 (0-3): ";
+    std::cout << "请输入选择 (0-9): ";
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // --bench [结果文件]：运行基准测试并把结果写成 CSV，便于脚本定期运行、比较
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        HarnessConfig config;
+        if (argc > 2) {
+            config.outputFile = argv[2];
+        }
+        return BenchmarkHarness::run(config) ? 0 : 1;
+    }
+
+    // 带参数时进入非交互的批处理模式
+    if (argc > 1) {
+        BatchOptions options;
+        if (!BatchProcessor::parseArguments(argc, argv, options)) {
+            return 1;
+        }
+        return BatchProcessor::run(options);
+    }
+
     int choice;
 
     do {
@@ -185,6 +290,9 @@ int main() {
             }
         }
 
+        // 本次选择处理的各文件的统计信息
+        StatisticsAggregator stats;
+
         switch (choice) {
         case 0:
             std::cout << "感谢使用，再见！" << std::endl;
@@ -195,8 +303,9 @@ int main() {
 
             // 处理10个数据文件
             for (int i = 1; i <= 10; ++i) {
-                processFile(i);
+                processFile(i, stats);
             }
+            stats.save("../result/statistics.csv");
 
             std::cout << "\n=== 所有文件处理完成 ===" << std::endl;
             std::cout << "结果保存在 result/ 目录下" << std::endl;
@@ -216,6 +325,38 @@ int main() {
             }
             break;
 
+        case 4:
+            Benchmark::runAll();
+            break;
+
+        case 5:
+            Benchmark::runParallelScaling();
+            break;
+
+        case 6:
+            processStreamingFile();
+            break;
+
+        case 7:
+            convertDataFiles();
+            break;
+
+        case 8:
+            std::cout << "开始处理10个数据文件（二进制网格输出）..." << std::endl;
+
+            for (int i = 1; i <= 10; ++i) {
+                processFile(i, stats, true, true);
+            }
+            stats.save("../result/statistics.csv");
+
+            std::cout << "\n=== 所有文件处理完成 ===" << std::endl;
+            std::cout << "网格保存在 result/<编号>/mesh.bin" << std::endl;
+            break;
+
+        case 9:
+            BenchmarkHarness::run(HarnessConfig());
+            break;
+
         default:
             std::cout << "无效的选择，请重新输入" << std::endl;
             break;
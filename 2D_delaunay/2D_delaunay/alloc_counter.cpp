@@ -0,0 +1,51 @@
+﻿#include "alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// 替换全局的分配函数，只多两次原子加法，统计基准测试中剖分过程的堆分配次数
+namespace {
+    std::atomic<std::uint64_t> allocationCount{ 0 };
+    std::atomic<std::uint64_t> freeCount{ 0 };
+    std::atomic<std::uint64_t> allocatedBytes{ 0 };
+
+    void* allocate(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+
+    void release(void* p) {
+        if (!p) return;
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+        std::free(p);
+    }
+}
+
+AllocationCounts allocationCounts() {
+    AllocationCounts c;
+    c.allocations = allocationCount.load(std::memory_order_relaxed);
+    c.frees = freeCount.load(std::memory_order_relaxed);
+    c.bytes = allocatedBytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
@@ -0,0 +1,25 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+// 全局 operator new / delete 的调用计数（实现在 alloc_counter.cpp，替换了全局的分配函数）。
+// 计数在整个进程中累计，测量一段代码时在前后各取一次快照相减
+struct AllocationCounts {
+    std::uint64_t allocations = 0;  // operator new 调用次数
+    std::uint64_t frees = 0;        // operator delete 调用次数（不含空指针）
+    std::uint64_t bytes = 0;        // 累计申请的字节数
+
+    AllocationCounts operator-(const AllocationCounts& other) const {
+        AllocationCounts d;
+        d.allocations = allocations - other.allocations;
+        d.frees = frees - other.frees;
+        d.bytes = bytes - other.bytes;
+        return d;
+    }
+};
+
+// 当前的累计计数
+AllocationCounts allocationCounts();
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "vector2.h"
+#include "delaunay.h"
+#include "io.h"
+#include "point_file.h"
+#include "mesh_file.h"
+#include "statistics.h"
+#include "thread_pool.h"
+#include <vector>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <cstdlib>
+
+// 命令行批处理参数
+struct BatchOptions {
+    std::string input;                          // 目录（处理其中所有文件）或通配符，如 tiles/*.txt
+    std::string outputDir = "../result/batch";  // 每个输入文件的结果写到 outputDir/<文件名>/
+    unsigned threads = 0;                       // 0 表示使用全部硬件线程
+    bool binaryOutput = false;                  // 结果写成 mesh.bin，代替 edges.txt / triangles.txt
+};
+
+// 非交互的批处理：列出输入文件，在线程池上并发剖分，每个文件一个结果目录，
+// 统计信息经 StatisticsAggregator 汇总后写入 outputDir/statistics.csv。
+// 一个文件只由一个线程处理，并行度来自文件之间，适合大量中小规模的分块数据
+class BatchProcessor {
+public:
+    static void printUsage(const char* program) {
+        std::cout << "用法: " << program << " <目录或通配符> [-o 输出目录] [-j 线程数] [--binary]" << std::endl;
+        std::cout << "  不带参数运行时进入交互菜单" << std::endl;
+        std::cout << "  通配符只作用于文件名部分，支持 * 和 ?，如 tiles/*.txt（需加引号避免被 shell 展开）" << std::endl;
+        std::cout << "  .bin 文件按二进制点文件读取，其余文件按文本点文件（每行 \"x y\"）读取" << std::endl;
+    }
+
+    // 解析命令行参数，参数有误时输出用法并返回 false
+    static bool parseArguments(int argc, char** argv, BatchOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+                options.outputDir = argv[++i];
+            }
+            else if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+                options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (arg == "--binary") {
+                options.binaryOutput = true;
+            }
+            else if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return false;
+            }
+            else if (options.input.empty() && arg[0] != '-') {
+                options.input = arg;
+            }
+            else {
+                std::cerr << "无法识别的参数: " << arg << std::endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+        if (options.input.empty()) {
+            printUsage(argv[0]);
+            return false;
+        }
+        while (options.outputDir.size() > 1 && options.outputDir.back() == '/') {
+            options.outputDir.pop_back();
+        }
+        return true;
+    }
+
+    // 通配符匹配：* 匹配任意多个字符，? 匹配一个字符
+    static bool matchPattern(const char* pattern, const char* name) {
+        const char* star = nullptr;
+        const char* resume = nullptr;
+        while (*name) {
+            if (*pattern == '?' || *pattern == *name) {
+                ++pattern;
+                ++name;
+            }
+            else if (*pattern == '*') {
+                star = pattern++;
+                resume = name;
+            }
+            else if (star) {
+                pattern = star + 1;
+                name = ++resume;
+            }
+            else {
+                return false;
+            }
+        }
+        while (*pattern == '*') ++pattern;
+        return *pattern == '\0';
+    }
+
+    // 列出输入文件（按路径排序）：目录取其中所有普通文件，否则把最后一级当作文件名通配符
+    static std::vector<std::string> listInputFiles(const std::string& input) {
+        namespace fs = std::filesystem;
+        std::vector<std::string> files;
+        std::error_code ec;
+
+        fs::path dir;
+        std::string pattern = "*";
+        if (fs::is_directory(input, ec)) {
+            dir = input;
+        }
+        else if (input.find_first_of("*?") == std::string::npos) {
+            if (fs::is_regular_file(input, ec)) files.push_back(input);
+            return files;
+        }
+        else {
+            const fs::path path(input);
+            dir = path.has_parent_path() ? path.parent_path() : fs::path(".");
+            pattern = path.filename().string();
+        }
+
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec) && matchPattern(pattern.c_str(), it->path().filename().string().c_str())) {
+                files.push_back(it->path().generic_string());
+            }
+        }
+        if (ec) {
+            std::cerr << "无法读取目录: " << dir.string() << std::endl;
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    // 剖分一个文件并把结果写到 resultDir，成功时把统计加入 stats
+    static bool processFile(const std::string& dataFile, const std::string& resultDir, bool binaryOutput,
+        StatisticsAggregator& stats, FileStatistics& record) {
+        std::vector<Vector2<float>> points;
+        MappedPoints<float> mapped;
+        const bool binaryInput = std::filesystem::path(dataFile).extension() == ".bin";
+        if (binaryInput) {
+            if (!mapped.open(dataFile)) return false;
+        }
+        else {
+            points = FileIO::readPointsFromFile(dataFile, nullptr, false);
+        }
+        const Vector2<float>* data = binaryInput ? mapped.data() : points.data();
+        record.pointCount = binaryInput ? mapped.size() : points.size();
+        if (record.pointCount == 0) {
+            std::cerr << "文件没有数据或读取失败: " << dataFile << std::endl;
+            return false;
+        }
+
+        // 每个线程复用同一个剖分对象，保留之前文件的缓冲区容量，大量小文件时不再反复分配
+        thread_local Delaunay<float> triangulation;
+        auto startTime = std::chrono::steady_clock::now();
+        if (binaryOutput) {
+            triangulation.triangulateIndexed(data, record.pointCount);
+        }
+        else {
+            triangulation.triangulate(data, record.pointCount);
+        }
+        auto endTime = std::chrono::steady_clock::now();
+        record.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+        // 计数放在计时之外，与交互模式一致：每条边只计一次，二进制输出直接由索引网格的邻接关系数出
+        record.triangleCount = binaryOutput ? triangulation.getMesh().triangleCount() : triangulation.getTriangles().size();
+        record.edgeCount = binaryOutput ? triangulation.getMesh().edgeCount() : triangulation.getEdges().size();
+
+        const bool saved = binaryOutput
+            ? saveMeshFile(triangulation.getMesh(), resultDir + "mesh.bin", true, false)
+            : FileIO::saveEdgesToFile(triangulation.getEdges(), resultDir + "edges.txt", false)
+                && FileIO::saveTrianglesToFile(triangulation.getTriangles(), resultDir + "triangles.txt", false);
+        // 结果引用本文件的点，映射的文件随后关闭
+        triangulation.reset();
+        if (!saved) return false;
+
+        stats.add(record);
+        return true;
+    }
+
+    // 执行批处理，返回进程退出码：全部成功为 0
+    static int run(const BatchOptions& options) {
+        const std::vector<std::string> files = listInputFiles(options.input);
+        if (files.empty()) {
+            std::cerr << "没有找到输入文件: " << options.input << std::endl;
+            return 1;
+        }
+        if (!FileIO::createDirectories(options.outputDir)) {
+            std::cerr << "无法创建输出目录: " << options.outputDir << std::endl;
+            return 1;
+        }
+
+        ThreadPool pool(options.threads);
+        std::cout << "批处理 " << files.size() << " 个文件，线程数: " << pool.size()
+            << "，结果保存到: " << options.outputDir << "/" << std::endl;
+
+        // 各文件的读取、保存信息不逐条输出（processFile 以 verbose = false 调用读写函数），
+        // 否则多个线程的输出会交错；每个文件只在锁内输出一行汇总
+        std::mutex logMutex;
+
+        StatisticsAggregator stats;
+        std::atomic<std::size_t> finished{ 0 }, failed{ 0 };
+        auto startTime = std::chrono::high_resolution_clock::now();
+        {
+            TaskGroup group(pool);
+            for (const std::string& dataFile : files) {
+                group.run([&, dataFile] {
+                    FileStatistics record;
+                    record.name = std::filesystem::path(dataFile).filename().string();
+                    // 目录名取完整文件名（含扩展名），tile.txt 与 tile.bin 的结果不会写到同一处
+                    const std::string resultDir = options.outputDir + "/" + record.name + "/";
+                    const bool ok = processFile(dataFile, resultDir, options.binaryOutput, stats, record);
+                    if (!ok) ++failed;
+
+                    const std::size_t done = ++finished;
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    std::cout << "[" << done << "/" << files.size() << "] " << dataFile;
+                    if (ok) {
+                        std::cout << ": " << record.pointCount << " 个点, " << record.triangleCount << " 个三角形, "
+                            << record.duration / 1000 << " 微秒" << std::endl;
+                    }
+                    else {
+                        std::cout << ": 失败" << std::endl;
+                    }
+                });
+            }
+            group.wait();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        const FileStatistics total = stats.total();
+        stats.save(options.outputDir + "/statistics.csv");
+
+        std::cout << "\n=== 批处理完成 ===" << std::endl;
+        std::cout << "  - 成功: " << stats.size() << " 个文件，失败: " << failed.load() << " 个" << std::endl;
+        std::cout << "  - 总点数: " << total.pointCount << std::endl;
+        std::cout << "  - 总三角形数: " << total.triangleCount << std::endl;
+        std::cout << "  - 剖分耗时合计: " << total.duration / 1000000 << " 毫秒" << std::endl;
+        std::cout << "  - 总耗时: " << static_cast<long long>(seconds * 1000.0) << " 毫秒 ("
+            << (seconds > 0 ? files.size() / seconds : 0.0) << " 个文件/秒)" << std::endl;
+        return failed.load() == 0 ? 0 : 1;
+    }
+};
+
+#endif
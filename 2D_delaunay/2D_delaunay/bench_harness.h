@@ -0,0 +1,223 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include "vector2.h"
+#include "delaunay.h"
+#include "io.h"
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// 基准测试的点分布
+enum class PointDistribution {
+    Uniform,    // [0,800]×[0,600] 内均匀分布
+    Normal,     // 以中心为均值的二维正态分布
+    Clustered,  // 20 个簇，每簇为小方差的正态分布
+    Grid,       // 整数网格，大量四点共圆，考验鲁棒谓词
+    // 以下为压力测试用的退化分布，默认的基准测试不包含
+    Circle,     // 圆周上等间距的点（坐标舍入后近似共圆），顺序随机打乱
+    Parabola,   // 抛物线上的点，全部处于凸位置
+    SortedGrid  // 整数网格，逐列按顺序给出，不打乱
+};
+
+// 一组计时样本的统计量（纳秒）
+struct TimingSummary {
+    std::int64_t min = 0;
+    std::int64_t median = 0;
+    std::int64_t p95 = 0;
+    double mean = 0;
+};
+
+// 基准测试参数；warmup / trials 为 0 时按点数自动选择（点数越少重复越多）
+struct HarnessConfig {
+    std::vector<int> pointCounts = { 1000, 10000, 100000, 1000000 };
+    std::vector<PointDistribution> distributions = {
+        PointDistribution::Uniform, PointDistribution::Normal, PointDistribution::Clustered, PointDistribution::Grid };
+    int warmup = 0;
+    int trials = 0;
+    bool spatialSort = false;
+    std::uint32_t seed = 12345;
+    std::string outputFile = "../result/benchmark.csv";
+};
+
+// 三角剖分基准测试：每组（分布, 点数）先做若干次预热，再重复计时，报告总耗时和各阶段耗时的
+// 最小值、中位数、p95 与平均值。点集由固定种子生成，每次运行的输入相同；
+// 结果写成 CSV（每行一个阶段），便于不同版本之间比较、跟踪性能回退
+class BenchmarkHarness {
+public:
+    static const char* distributionName(PointDistribution d) {
+        switch (d) {
+        case PointDistribution::Uniform: return "uniform";
+        case PointDistribution::Normal: return "normal";
+        case PointDistribution::Clustered: return "clustered";
+        case PointDistribution::Grid: return "grid";
+        case PointDistribution::Circle: return "circle";
+        case PointDistribution::Parabola: return "parabola";
+        case PointDistribution::SortedGrid: return "sorted_grid";
+        }
+        return "unknown";
+    }
+
+    // 按分布生成 n 个点，相同的种子得到相同的点集
+    static std::vector<Vector2<float>> generatePoints(PointDistribution d, int n, std::uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::vector<Vector2<float>> points;
+        points.reserve(n);
+        switch (d) {
+        case PointDistribution::Uniform: {
+            std::uniform_real_distribution<float> x(0, 800), y(0, 600);
+            for (int i = 0; i < n; ++i) points.push_back(Vector2<float>(x(gen), y(gen)));
+            break;
+        }
+        case PointDistribution::Normal: {
+            std::normal_distribution<float> x(400, 100), y(300, 75);
+            for (int i = 0; i < n; ++i) points.push_back(Vector2<float>(x(gen), y(gen)));
+            break;
+        }
+        case PointDistribution::Clustered: {
+            std::uniform_real_distribution<float> cx(0, 800), cy(0, 600);
+            std::vector<Vector2<float>> centers;
+            for (int k = 0; k < 20; ++k) centers.push_back(Vector2<float>(cx(gen), cy(gen)));
+            std::uniform_int_distribution<int> pick(0, 19);
+            std::normal_distribution<float> offset(0, 10);
+            for (int i = 0; i < n; ++i) {
+                const Vector2<float>& c = centers[pick(gen)];
+                points.push_back(Vector2<float>(c.x + offset(gen), c.y + offset(gen)));
+            }
+            break;
+        }
+        case PointDistribution::Grid: {
+            // 网格按列优先填满，点的顺序再随机打乱，避免逐行插入的最坏情况
+            const int side = static_cast<int>(std::ceil(std::sqrt(double(n))));
+            for (int i = 0; i < n; ++i) points.push_back(Vector2<float>(float(i / side), float(i % side)));
+            std::shuffle(points.begin(), points.end(), gen);
+            break;
+        }
+        case PointDistribution::Circle: {
+            for (int i = 0; i < n; ++i) {
+                const double a = 6.283185307179586 * i / n;
+                points.push_back(Vector2<float>(float(400 + 300 * std::cos(a)), float(300 + 300 * std::sin(a))));
+            }
+            std::shuffle(points.begin(), points.end(), gen);
+            break;
+        }
+        case PointDistribution::Parabola: {
+            std::uniform_real_distribution<float> x(0, 800);
+            for (int i = 0; i < n; ++i) {
+                const float v = x(gen);
+                points.push_back(Vector2<float>(v, v * v / 800));
+            }
+            break;
+        }
+        case PointDistribution::SortedGrid: {
+            const int side = static_cast<int>(std::ceil(std::sqrt(double(n))));
+            for (int i = 0; i < n; ++i) points.push_back(Vector2<float>(float(i / side), float(i % side)));
+            break;
+        }
+        }
+        return points;
+    }
+
+    // 由样本计算统计量，p95 取最近秩
+    static TimingSummary summarize(std::vector<std::int64_t> samples) {
+        TimingSummary s;
+        if (samples.empty()) return s;
+        std::sort(samples.begin(), samples.end());
+        const std::size_t n = samples.size();
+        s.min = samples[0];
+        s.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+        s.p95 = samples[static_cast<std::size_t>(std::ceil(0.95 * n)) - 1];
+        double sum = 0;
+        for (std::int64_t v : samples) sum += double(v);
+        s.mean = sum / n;
+        return s;
+    }
+
+    // 运行全部组合并写出 CSV，无法写出结果文件时返回 false
+    static bool run(const HarnessConfig& config) {
+        std::cout << "\n=== 三角剖分基准测试 ===" << std::endl;
+
+        // 确保目录存在
+        size_t lastSlash = config.outputFile.find_last_of('/');
+        if (lastSlash != std::string::npos) {
+            std::string dir = config.outputFile.substr(0, lastSlash);
+            if (!FileIO::createDirectories(dir)) {
+                std::cerr << "无法创建目录: " << dir << std::endl;
+                return false;
+            }
+        }
+        std::ofstream file(config.outputFile);
+        if (!file.is_open()) {
+            std::cerr << "无法创建文件: " << config.outputFile << std::endl;
+            return false;
+        }
+        file << "distribution,points,triangles,spatial_sort,warmup,trials,phase,min_ns,median_ns,p95_ns,mean_ns\n";
+
+        static const char* phaseNames[PHASE_COUNT] = { "total", "bounds", "super_triangle", "insertion", "cleanup", "edges" };
+        for (PointDistribution d : config.distributions) {
+            for (int n : config.pointCounts) {
+                const std::vector<Vector2<float>> points = generatePoints(d, n, config.seed);
+                const int trials = config.trials > 0 ? config.trials : std::max(5, std::min(50, 2000000 / std::max(n, 1)));
+                const int warmup = config.warmup > 0 ? config.warmup : std::max(1, trials / 5);
+
+                std::vector<std::int64_t> samples[PHASE_COUNT];
+                std::size_t triangleCount = 0;
+                for (int t = 0; t < warmup + trials; ++t) {
+                    Delaunay<float> triangulation;
+                    triangulation.setSpatialSort(config.spatialSort);
+                    auto startTime = std::chrono::steady_clock::now();
+                    triangleCount = triangulation.triangulate(points.data(), points.size()).size();
+                    // 边按需生成，这里取一次，计入总耗时与 edges 阶段
+                    triangulation.getEdges();
+                    auto endTime = std::chrono::steady_clock::now();
+                    if (t < warmup) continue;
+
+                    const Delaunay<float>::PhaseTimes& phases = triangulation.lastPhaseTimes();
+                    samples[0].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+                    samples[1].push_back(phases.bounds);
+                    samples[2].push_back(phases.superTriangle);
+                    samples[3].push_back(phases.insertion);
+                    samples[4].push_back(phases.cleanup);
+                    samples[5].push_back(phases.edges);
+                }
+
+                TimingSummary summary[PHASE_COUNT];
+                for (int k = 0; k < PHASE_COUNT; ++k) {
+                    summary[k] = summarize(samples[k]);
+                    file << distributionName(d) << "," << n << "," << triangleCount << "," << config.spatialSort << ","
+                        << warmup << "," << trials << "," << phaseNames[k] << "," << summary[k].min << ","
+                        << summary[k].median << "," << summary[k].p95 << "," << static_cast<std::int64_t>(summary[k].mean) << "\n";
+                }
+
+                std::cout << distributionName(d) << " " << n << " 个点 (" << trials << " 次): 中位数 "
+                    << summary[0].median / 1000 << " 微秒, p95 " << summary[0].p95 / 1000 << " 微秒, 最小 "
+                    << summary[0].min / 1000 << " 微秒" << std::endl;
+                std::cout << "  各阶段中位数(微秒):";
+                for (int k = 1; k < PHASE_COUNT; ++k) {
+                    std::cout << " " << phaseNames[k] << " " << summary[k].median / 1000;
+                }
+                std::cout << std::endl;
+            }
+        }
+
+        file.close();
+        if (!file) {
+            std::cerr << "写入文件失败: " << config.outputFile << std::endl;
+            return false;
+        }
+        std::cout << "基准测试结果保存到: " << config.outputFile << std::endl;
+        return true;
+    }
+
+private:
+    // 总耗时加 5 个阶段
+    static constexpr int PHASE_COUNT = 6;
+};
+
+#endif
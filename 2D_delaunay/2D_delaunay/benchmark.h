@@ -0,0 +1,921 @@
+#pragma once
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "vector2.h"
+#include "triangle.h"
+#include "delaunay.h"
+#include "circumcircle.h"
+#include "io.h"
+#include "thread_pool.h"
+#include "spatial_sort.h"
+#include "streaming.h"
+#include "point_file.h"
+#include "mesh_file.h"
+#include "text_parser.h"
+#include "alloc_counter.h"
+#include "bench_harness.h"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+class Benchmark {
+public:
+    // 依次运行全部性能测试
+    static void runAll() {
+        runTriangulationScaling();
+        runEngines(1000000);
+        runAdversarial(100000);
+        runSpatialSort(1000000);
+        runOutputMemory(1000000);
+        runDynamicUpdates(100000, 20);
+        runStreaming(1000000);
+        runPointLoading(1000000);
+        runTextParsing(1000000);
+        runMeshOutput(1000000);
+        runInstrumentation(1000000);
+        runAllocations(1000000, 100000);
+        runSmallInputs(10000, 256);
+        runCavityBoundary();
+        runInCircleThroughput();
+    }
+
+    // 不同规模的随机点集上测试三角剖分耗时，用于观察增长阶数
+    static void runTriangulationScaling() {
+        std::cout << "\n=== 三角剖分规模测试 ===" << std::endl;
+        std::cout << std::setw(10) << "点数" << std::setw(12) << "三角形数"
+            << std::setw(14) << "耗时(毫秒)" << std::setw(22) << "ns / (n log2 n)" << std::endl;
+
+        const int sizes[] = { 1000, 10000, 100000, 1000000 };
+        for (int n : sizes) {
+            std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            Delaunay<float> triangulation;
+            const std::vector<Triangle<float>>& triangles = triangulation.triangulate(points);
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            const double ns = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+            std::cout << std::setw(10) << n << std::setw(12) << triangles.size()
+                << std::setw(14) << std::fixed << std::setprecision(1) << ns / 1e6
+                << std::setw(22) << std::setprecision(2) << ns / (n * std::log2(double(n))) << std::endl;
+        }
+    }
+
+    // 逐点插入与扫描凸包两种剖分算法对比：均匀、成簇、整数网格三种分布（固定种子），各取 3 次的最小值，
+    // 并核对两者是否得到同一组三角形。网格上大量四点共圆，两种算法选的对角线可以不同，此时只比较三角形数
+    static void runEngines(int n) {
+        std::cout << "\n=== 剖分算法对比 (" << n << " 个点) ===" << std::endl;
+        std::cout << std::setw(12) << "分布" << std::setw(18) << "逐点插入(毫秒)" << std::setw(18) << "扫描凸包(毫秒)"
+            << std::setw(10) << "加速比" << "  结果" << std::endl;
+
+        const PointDistribution distributions[] = { PointDistribution::Uniform, PointDistribution::Clustered, PointDistribution::Grid };
+        const DelaunayEngine engines[] = { DelaunayEngine::BowyerWatson, DelaunayEngine::SweepHull };
+        for (PointDistribution d : distributions) {
+            const std::vector<Vector2<float>> points = BenchmarkHarness::generatePoints(d, n, 12345);
+            double ms[2];
+            std::vector<std::array<std::uint32_t, 3>> triangles[2];
+            for (int k = 0; k < 2; ++k) {
+                ms[k] = 0;
+                for (int trial = 0; trial < 3; ++trial) {
+                    Delaunay<float> triangulation;
+                    triangulation.setEngine(engines[k]);
+                    auto startTime = std::chrono::high_resolution_clock::now();
+                    const IndexedMesh<float>& mesh = triangulation.triangulateIndexed(points.data(), points.size());
+                    auto endTime = std::chrono::high_resolution_clock::now();
+                    const double t = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+                    ms[k] = trial == 0 ? t : std::min(ms[k], t);
+                    if (trial == 0) triangles[k] = sortedTriangles(mesh);
+                }
+            }
+
+            const char* result = triangles[0] == triangles[1] ? "同一组三角形"
+                : triangles[0].size() == triangles[1].size() ? "三角形数相同（共圆处对角线不同）" : "三角形数不一致";
+            std::cout << std::setw(12) << BenchmarkHarness::distributionName(d) << std::setw(18) << std::fixed
+                << std::setprecision(1) << ms[0] << std::setw(18) << ms[1] << std::setw(10) << std::setprecision(2)
+                << ms[0] / ms[1] << "  " << result << std::endl;
+        }
+    }
+
+    // 退化输入的压力测试：圆周、抛物线（全部处于凸位置）、按顺序给出的整数网格，三种剖分算法各剖分一次，
+    // 分治另用默认线程池并行剖分一次，并逐条内部边用精确谓词检查结果是否满足空圆性质
+    static void runAdversarial(int n) {
+        std::cout << "\n=== 退化输入压力测试 (" << n << " 个点) ===" << std::endl;
+        std::cout << std::setw(14) << "分布" << std::setw(16) << "逐点插入(毫秒)" << std::setw(16) << "扫描凸包(毫秒)"
+            << std::setw(14) << "分治(毫秒)" << std::setw(18) << "并行分治(毫秒)" << "  结果" << std::endl;
+
+        ThreadPool pool;
+        const PointDistribution distributions[] = { PointDistribution::Circle, PointDistribution::Parabola, PointDistribution::SortedGrid };
+        const DelaunayEngine engines[] = { DelaunayEngine::BowyerWatson, DelaunayEngine::SweepHull,
+            DelaunayEngine::DivideAndConquer, DelaunayEngine::DivideAndConquer };
+        for (PointDistribution d : distributions) {
+            const std::vector<Vector2<float>> points = BenchmarkHarness::generatePoints(d, n, 12345);
+            double ms[4];
+            std::size_t count[4];
+            bool valid = true;
+            for (int k = 0; k < 4; ++k) {
+                Delaunay<float> triangulation;
+                triangulation.setEngine(engines[k]);
+                auto startTime = std::chrono::high_resolution_clock::now();
+                const IndexedMesh<float>& mesh = k == 3 ? triangulation.triangulateIndexed(points.data(), points.size(), pool)
+                    : triangulation.triangulateIndexed(points.data(), points.size());
+                auto endTime = std::chrono::high_resolution_clock::now();
+                ms[k] = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+                count[k] = mesh.triangleCount();
+                valid = valid && isDelaunay(mesh);
+            }
+
+            const bool same = count[0] == count[1] && count[0] == count[2] && count[0] == count[3];
+            std::cout << std::setw(14) << BenchmarkHarness::distributionName(d) << std::fixed << std::setprecision(1)
+                << std::setw(16) << ms[0] << std::setw(16) << ms[1] << std::setw(14) << ms[2] << std::setw(18) << ms[3]
+                << "  " << (!valid ? "不满足空圆性质" : same ? "均为 Delaunay 剖分" : "三角形数不一致") << std::endl;
+        }
+    }
+
+    // 插入顺序对剖分耗时的影响：输入顺序与 BRIO / Hilbert 重排对比（重排耗时计入总时间），
+    // 随机顺序之外再测一组按 x 排序的输入，模拟逐行扫描得到的数据文件
+    static void runSpatialSort(int n) {
+        std::cout << "\n=== BRIO / Hilbert 插入顺序 (" << n << " 个点) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+        std::cout << std::setw(12) << "输入顺序" << std::setw(16) << "原顺序(毫秒)" << std::setw(16) << "重排(毫秒)"
+            << std::setw(16) << "其中排序(毫秒)" << std::setw(10) << "加速比" << std::endl;
+        for (int sorted = 0; sorted < 2; ++sorted) {
+            if (sorted) {
+                std::sort(points.begin(), points.end(), [](const Vector2<float>& a, const Vector2<float>& b) {
+                    return a.x < b.x;
+                    });
+            }
+
+            double ms[2];
+            std::size_t count[2];
+            for (int brio = 0; brio < 2; ++brio) {
+                auto startTime = std::chrono::high_resolution_clock::now();
+                Delaunay<float> triangulation;
+                triangulation.setSpatialSort(brio != 0);
+                count[brio] = triangulation.triangulateIndexed(points).triangleCount();
+                auto endTime = std::chrono::high_resolution_clock::now();
+                ms[brio] = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+            }
+
+            auto sortStart = std::chrono::high_resolution_clock::now();
+            const std::vector<std::uint32_t> order = brioOrder(points);
+            auto sortEnd = std::chrono::high_resolution_clock::now();
+            const double sortMs = std::chrono::duration<double, std::milli>(sortEnd - sortStart).count();
+
+            std::cout << std::setw(12) << (sorted ? "按 x 排序" : "随机") << std::setw(16) << std::fixed
+                << std::setprecision(1) << ms[0] << std::setw(16) << ms[1] << std::setw(16) << sortMs
+                << std::setw(10) << std::setprecision(2) << ms[0] / ms[1]
+                << (count[0] == count[1] && order.size() == points.size() ? "" : "  (三角形数不一致)") << std::endl;
+        }
+    }
+
+    // 动态更新与整体重建对比：每一帧删除、移动、插入各 1/300 的点（共约 1% 的点发生变化），
+    // 并做 1% 点数的点定位查询；对照组每帧用当前的点重新剖分。两者都是精确的 Delaunay 剖分，
+    // 最后一帧的三角形数应当相同
+    static void runDynamicUpdates(int n, int ticks) {
+        std::cout << "\n=== 动态更新 (" << n << " 个点, " << ticks << " 帧) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<float> coordX(0.0f, 800.0f);
+        std::uniform_real_distribution<float> coordY(0.0f, 600.0f);
+        std::uniform_real_distribution<float> jitter(-5.0f, 5.0f);
+        const int churn = std::max(1, n / 300);
+        const int queries = std::max(1, n / 100);
+
+        Delaunay<float> triangulation;
+        triangulation.triangulateIndexed(points);
+        std::vector<std::uint32_t> alive(points.size());
+        for (std::size_t i = 0; i < alive.size(); ++i) alive[i] = static_cast<std::uint32_t>(i);
+
+        double updateMs = 0, queryMs = 0, rebuildMs = 0;
+        std::size_t found = 0;
+        std::size_t dynamicCount = 0, rebuildCount = 0;
+        for (int tick = 0; tick < ticks; ++tick) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (int k = 0; k < churn; ++k) {
+                std::size_t slot = gen() % alive.size();
+                triangulation.remove(alive[slot]);
+                alive[slot] = alive.back();
+                alive.pop_back();
+
+                slot = gen() % alive.size();
+                const Vector2<float>& p = points[alive[slot]];
+                Vector2<float> target(p.x + jitter(gen), p.y + jitter(gen));
+                if (triangulation.move(alive[slot], target)) {
+                    points[alive[slot]] = target;
+                }
+                else {
+                    alive[slot] = alive.back();
+                    alive.pop_back();
+                }
+
+                const Vector2<float> q(coordX(gen), coordY(gen));
+                const std::uint32_t id = triangulation.insert(q);
+                if (id == points.size()) {
+                    points.push_back(q);
+                    alive.push_back(id);
+                }
+            }
+            dynamicCount = triangulation.buildMesh().triangleCount();
+            auto midTime = std::chrono::high_resolution_clock::now();
+
+            std::uint32_t corners[3];
+            for (int k = 0; k < queries; ++k) {
+                found += triangulation.findTriangle(Vector2<float>(coordX(gen), coordY(gen)), corners);
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+            updateMs += std::chrono::duration<double, std::milli>(midTime - startTime).count();
+            queryMs += std::chrono::duration<double, std::milli>(endTime - midTime).count();
+
+            // 对照组：用当前存活的点整体重建
+            std::vector<Vector2<float>> current(alive.size());
+            for (std::size_t i = 0; i < alive.size(); ++i) current[i] = points[alive[i]];
+            auto rebuildStart = std::chrono::high_resolution_clock::now();
+            Delaunay<float> fresh;
+            rebuildCount = fresh.triangulateIndexed(current).triangleCount();
+            auto rebuildEnd = std::chrono::high_resolution_clock::now();
+            rebuildMs += std::chrono::duration<double, std::milli>(rebuildEnd - rebuildStart).count();
+        }
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "每帧更新 " << 3 * churn << " 次: " << updateMs / ticks << " 毫秒 ("
+            << updateMs * 1e3 / (double(ticks) * 3 * churn) << " 微秒/次, 含 buildMesh)" << std::endl;
+        std::cout << "每帧查询 " << queries << " 次: " << queryMs / ticks << " 毫秒, 命中 " << found << std::endl;
+        std::cout << "每帧整体重建: " << rebuildMs / ticks << " 毫秒, 加速比 " << rebuildMs / updateMs << std::endl;
+        std::cout << "最后一帧三角形数: 动态更新 " << dynamicCount << ", 重建 " << rebuildCount << std::endl;
+    }
+
+    // 流式剖分与一次性剖分对比：同一组点分别按随机顺序、按 x 排序、按 50x50 的块组织输入，
+    // 比较耗时、输出的三角形数，以及流式剖分同时驻留内存的三角形数峰值
+    static void runStreaming(int n) {
+        std::cout << "\n=== 流式剖分 (" << n << " 个点) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+        float minX = points[0].x, minY = points[0].y, maxX = minX, maxY = minY;
+        for (const auto& p : points) {
+            minX = std::min(minX, p.x);
+            minY = std::min(minY, p.y);
+            maxX = std::max(maxX, p.x);
+            maxY = std::max(maxY, p.y);
+        }
+
+        std::cout << std::setw(12) << "输入顺序" << std::setw(16) << "一次性(毫秒)" << std::setw(14) << "流式(毫秒)"
+            << std::setw(14) << "驻留峰值" << std::setw(12) << "驻留比例" << "  结果" << std::endl;
+        const char* names[] = { "随机", "按 x 排序", "按块" };
+        for (int order = 0; order < 3; ++order) {
+            if (order == 1) {
+                std::sort(points.begin(), points.end(), [](const Vector2<float>& a, const Vector2<float>& b) {
+                    return a.x < b.x;
+                    });
+            }
+            else if (order == 2) {
+                auto tile = [](const Vector2<float>& p) { return int(p.y / 50) * 100 + int(p.x / 50); };
+                std::stable_sort(points.begin(), points.end(), [&tile](const Vector2<float>& a, const Vector2<float>& b) {
+                    return tile(a) < tile(b);
+                    });
+            }
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            std::size_t reference = 0;
+            {
+                std::vector<Vector2<float>> copy = points;
+                Delaunay<float> triangulation;
+                reference = triangulation.triangulateIndexed(copy).triangleCount();
+            }
+            auto midTime = std::chrono::high_resolution_clock::now();
+
+            StreamingDelaunay<float> streaming;
+            std::size_t emitted = 0;
+            auto emit = [&emitted](const Vector2<float>&, const Vector2<float>&, const Vector2<float>&) { ++emitted; };
+            streaming.begin(minX, minY, maxX, maxY, points.size() / 64 + 1);
+            for (const auto& p : points) streaming.count(p);
+            for (const auto& p : points) streaming.insert(p, emit);
+            streaming.finish(emit);
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            const std::size_t peak = streaming.stats().peakFaces;
+            std::cout << std::setw(12) << names[order] << std::setw(16) << std::fixed << std::setprecision(1)
+                << std::chrono::duration<double, std::milli>(midTime - startTime).count()
+                << std::setw(14) << std::chrono::duration<double, std::milli>(endTime - midTime).count()
+                << std::setw(14) << peak << std::setw(12) << std::setprecision(3) << double(peak) / emitted
+                << (emitted == reference ? "  三角形数一致" : "  三角形数不一致") << std::endl;
+        }
+    }
+
+    // 读入点集的耗时：文本文件逐行解析与二进制点文件内存映射对比。映射之后把所有坐标读一遍求和，
+    // 计入缺页的代价；操作系统缓存了刚写出的文件，测到的是不含磁盘读取的纯加载开销
+    static void runPointLoading(int n) {
+        std::cout << "\n=== 点文件加载 (" << n << " 个点) ===" << std::endl;
+        const std::string textFile = "point_load_bench.txt";
+        const std::string binaryFile = "point_load_bench.bin";
+        {
+            std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+            FileIO::savePointsToFile(points, textFile);
+        }
+
+        auto convertStart = std::chrono::high_resolution_clock::now();
+        convertPointFile<float>(textFile, binaryFile);
+        auto convertEnd = std::chrono::high_resolution_clock::now();
+
+        auto textStart = std::chrono::high_resolution_clock::now();
+        std::vector<Vector2<float>> textPoints = FileIO::readPointsFromFile(textFile);
+        auto textEnd = std::chrono::high_resolution_clock::now();
+
+        auto mapStart = std::chrono::high_resolution_clock::now();
+        MappedPoints<float> mapped(binaryFile);
+        double sum = 0;
+        for (const auto& p : mapped) sum += p.x + p.y;
+        auto mapEnd = std::chrono::high_resolution_clock::now();
+
+        double textSum = 0;
+        for (const auto& p : textPoints) textSum += p.x + p.y;
+
+        struct stat textInfo, binaryInfo;
+        stat(textFile.c_str(), &textInfo);
+        stat(binaryFile.c_str(), &binaryInfo);
+        const double textMs = std::chrono::duration<double, std::milli>(textEnd - textStart).count();
+        const double mapMs = std::chrono::duration<double, std::milli>(mapEnd - mapStart).count();
+        const double convertMs = std::chrono::duration<double, std::milli>(convertEnd - convertStart).count();
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "文本文件: " << textInfo.st_size / (1024.0 * 1024.0) << " MB, 读取 " << textMs << " 毫秒 ("
+            << textInfo.st_size / (1024.0 * 1024.0) / (textMs / 1000) << " MB/s)" << std::endl;
+        std::cout << "二进制文件: " << binaryInfo.st_size / (1024.0 * 1024.0) << " MB, 映射并读一遍 " << mapMs << " 毫秒 ("
+            << binaryInfo.st_size / (1024.0 * 1024.0) / (mapMs / 1000) << " MB/s)" << std::endl;
+        std::cout << "文本转二进制: " << convertMs << " 毫秒, 加载加速比 " << std::setprecision(2) << textMs / mapMs
+            << (mapped.size() == textPoints.size() && sum == textSum ? "  坐标一致" : "  坐标不一致") << std::endl;
+
+        mapped.close();
+        std::remove(textFile.c_str());
+        std::remove(binaryFile.c_str());
+    }
+
+    // 文本解析吞吐量（MB/s）：点文件与 PDB 文件各测一次。改进前为 getline + istringstream / substr + stod，
+    // 改进后为分块读入、from_chars 直接解析，并行版本把各块分给线程池
+    static void runTextParsing(int n) {
+        std::cout << "\n=== 文本解析吞吐量 (" << n << " 行) ===" << std::endl;
+        const std::string pointFile = "parse_bench.txt";
+        const std::string pdbFile = "parse_bench.pdb";
+        {
+            std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+            FileIO::savePointsToFile(points, pointFile);
+
+            std::ofstream pdb(pdbFile);
+            char line[96];
+            for (int i = 0; i < n; ++i) {
+                const Vector2<float>& p = points[i];
+                std::snprintf(line, sizeof(line), "%-6s%5d  CA  ALA A%4d    %8.3f%8.3f%8.3f  1.00 20.00           C\n",
+                    i % 10 == 0 ? "HETATM" : "ATOM", i % 100000, i % 10000, p.x - 400.0, p.y - 300.0, (p.x - p.y) * 0.5);
+                pdb << line;
+            }
+        }
+        struct stat pointInfo, pdbInfo;
+        stat(pointFile.c_str(), &pointInfo);
+        stat(pdbFile.c_str(), &pdbInfo);
+        ThreadPool pool;
+
+        auto measure = [](double bytes, auto&& parse) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            const std::size_t count = parse();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+            return std::make_pair(bytes / (1024.0 * 1024.0) / seconds, count);
+        };
+
+        auto pointLine = [](const char* first, const char* last, std::vector<Vector2<float>>& out) {
+            Vector2<float> p;
+            if (FileIO::parsePointLine(first, last, p)) out.push_back(p);
+        };
+        auto pdbLine = [](const char* line, const char* end, std::vector<std::array<double, 3>>& out) {
+            if (!textparse::startsWith(line, end, "ATOM") && !textparse::startsWith(line, end, "HETATM")) return;
+            std::array<double, 3> p;
+            if (textparse::parseField(line, end, 30, 8, p[0]) && textparse::parseField(line, end, 38, 8, p[1])
+                && textparse::parseField(line, end, 46, 8, p[2])) out.push_back(p);
+        };
+
+        const std::pair<double, std::size_t> rates[6] = {
+            measure(double(pointInfo.st_size), [&]() {
+                std::vector<Vector2<float>> points;
+                std::ifstream file(pointFile);
+                std::string line;
+                while (std::getline(file, line)) {
+                    std::istringstream iss(line);
+                    float x, y;
+                    if (iss >> x >> y) points.push_back(Vector2<float>(x, y));
+                }
+                return points.size();
+            }),
+            measure(double(pointInfo.st_size), [&]() {
+                std::vector<Vector2<float>> points;
+                textparse::parseLines(pointFile, points, pointLine);
+                return points.size();
+            }),
+            measure(double(pointInfo.st_size), [&]() {
+                std::vector<Vector2<float>> points;
+                textparse::parseLines(pointFile, points, pointLine, &pool);
+                return points.size();
+            }),
+            measure(double(pdbInfo.st_size), [&]() {
+                std::vector<std::array<double, 3>> atoms;
+                std::ifstream file(pdbFile);
+                std::string line;
+                while (std::getline(file, line)) {
+                    if (line.substr(0, 4) == "ATOM" || line.substr(0, 6) == "HETATM") {
+                        if (line.length() >= 54) {
+                            try {
+                                atoms.push_back({ std::stod(line.substr(30, 8)), std::stod(line.substr(38, 8)), std::stod(line.substr(46, 8)) });
+                            }
+                            catch (...) {
+                            }
+                        }
+                    }
+                }
+                return atoms.size();
+            }),
+            measure(double(pdbInfo.st_size), [&]() {
+                std::vector<std::array<double, 3>> atoms;
+                textparse::parseLines(pdbFile, atoms, pdbLine);
+                return atoms.size();
+            }),
+            measure(double(pdbInfo.st_size), [&]() {
+                std::vector<std::array<double, 3>> atoms;
+                textparse::parseLines(pdbFile, atoms, pdbLine, &pool);
+                return atoms.size();
+            })
+        };
+
+        const char* names[6] = { "点文件 getline + istringstream", "点文件 分块 from_chars", "点文件 分块并行",
+            "PDB substr + stod", "PDB 分块按列 from_chars", "PDB 分块并行" };
+        std::cout << std::fixed << std::setprecision(1);
+        for (int k = 0; k < 6; ++k) {
+            std::cout << names[k] << ": " << rates[k].first << " MB/s, " << rates[k].second << " 条记录" << std::endl;
+        }
+        std::cout << "并行线程数: " << pool.size() << std::endl;
+
+        std::remove(pointFile.c_str());
+        std::remove(pdbFile.c_str());
+    }
+
+    // 比较文本 edges.txt / triangles.txt 与二进制网格文件的写出时间和大小，并读回二进制文件核对
+    static void runMeshOutput(int n) {
+        std::cout << "\n=== 网格输出格式对比 (" << n << " 个点) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+        Delaunay<float> triangulation;
+        triangulation.triangulate(points);
+        const IndexedMesh<float>& mesh = triangulation.buildMesh();
+
+        const std::string edgeFile = "mesh_bench_edges.txt";
+        const std::string triangleFile = "mesh_bench_triangles.txt";
+        const std::string rawFile = "mesh_bench_raw.bin";
+        const std::string packedFile = "mesh_bench_packed.bin";
+
+        auto fileBytes = [](const std::string& filename) {
+            struct stat info;
+            return stat(filename.c_str(), &info) == 0 ? double(info.st_size) : 0.0;
+        };
+        auto measure = [](auto&& write) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            write();
+            auto endTime = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        };
+
+        const double textMs = measure([&]() {
+            FileIO::saveEdgesToFile(triangulation.getEdges(), edgeFile);
+            FileIO::saveTrianglesToFile(triangulation.getTriangles(), triangleFile);
+        });
+        const double rawMs = measure([&]() { saveMeshFile(mesh, rawFile, false); });
+        const double packedMs = measure([&]() { saveMeshFile(mesh, packedFile, true); });
+
+        std::vector<Vector2<float>> vertices;
+        std::vector<std::uint32_t> triangles;
+        bool same = true;
+        double readMs[2];
+        const std::string* files[2] = { &rawFile, &packedFile };
+        for (int k = 0; k < 2; ++k) {
+            readMs[k] = measure([&]() { same = loadMeshFile(*files[k], vertices, triangles) && same; });
+            same = same && triangles == mesh.triangles && vertices.size() == mesh.vertexCount;
+            for (std::size_t i = 0; same && i < vertices.size(); ++i) same = vertices[i] == mesh.vertex(static_cast<std::uint32_t>(i));
+        }
+
+        const double mb = 1024.0 * 1024.0;
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "文本 edges.txt + triangles.txt: " << textMs << " 毫秒, "
+            << (fileBytes(edgeFile) + fileBytes(triangleFile)) / mb << " MB" << std::endl;
+        std::cout << "二进制网格（未压缩）: " << rawMs << " 毫秒, " << fileBytes(rawFile) / mb << " MB, 读回 "
+            << readMs[0] << " 毫秒" << std::endl;
+        std::cout << "二进制网格（差分 + 变长编码）: " << packedMs << " 毫秒, " << fileBytes(packedFile) / mb << " MB, 读回 "
+            << readMs[1] << " 毫秒" << std::endl;
+        std::cout << "读回结果与内存中的网格" << (same ? "一致" : "不一致") << std::endl;
+
+        std::remove(edgeFile.c_str());
+        std::remove(triangleFile.c_str());
+        std::remove(rawFile.c_str());
+        std::remove(packedFile.c_str());
+    }
+
+    // 比较 Triangle/Edge 对象输出与索引网格输出的内存占用
+    static void runOutputMemory(int n) {
+        std::cout << "\n=== 输出内存对比 (" << n << " 个点) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+
+        std::size_t objectBytes = 0;
+        {
+            Delaunay<float> triangulation;
+            triangulation.triangulate(points);
+            objectBytes = triangulation.getTriangles().capacity() * sizeof(Triangle<float>)
+                + triangulation.getEdges().capacity() * sizeof(Edge<float>);
+        }
+
+        Delaunay<float> triangulation;
+        const IndexedMesh<float>& mesh = triangulation.triangulateIndexed(points);
+        const std::size_t meshBytes = mesh.memoryBytes();
+        const std::size_t edgeCount = mesh.uniqueEdges().size() / 2;
+
+        std::cout << "Triangle/Edge 对象: " << objectBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+        std::cout << "索引网格: " << meshBytes / (1024.0 * 1024.0) << " MB, "
+            << mesh.triangleCount() << " 个三角形, " << edgeCount << " 条不重复的边" << std::endl;
+        std::cout << "压缩比: " << double(objectBytes) / meshBytes << std::endl;
+    }
+
+    // 插桩的代价：同一点集分别用不插桩、计数、追踪三种策略剖分，取 5 次的中位数；
+    // 输出计数结果，并把时间线写到 trace.json（可在 chrome://tracing 中打开）
+    static void runInstrumentation(int n) {
+        std::cout << "\n=== 剖分插桩 (" << n << " 个点) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+
+        auto median = [&](auto&& triangulate) {
+            std::vector<double> ms;
+            for (int t = 0; t < 5; ++t) {
+                auto startTime = std::chrono::high_resolution_clock::now();
+                triangulate();
+                auto endTime = std::chrono::high_resolution_clock::now();
+                ms.push_back(std::chrono::duration<double, std::milli>(endTime - startTime).count());
+            }
+            std::sort(ms.begin(), ms.end());
+            return ms[2];
+        };
+
+        const double plainMs = median([&]() {
+            Delaunay<float> triangulation;
+            triangulation.triangulateIndexed(points);
+        });
+        CountingInstrumentation counts;
+        const double countingMs = median([&]() {
+            Delaunay<float, CountingInstrumentation> triangulation;
+            triangulation.triangulateIndexed(points);
+            counts = triangulation.instrumentation();
+        });
+        TracingInstrumentation trace;
+        const double tracingMs = median([&]() {
+            Delaunay<float, TracingInstrumentation> triangulation;
+            triangulation.triangulateIndexed(points);
+            trace = triangulation.instrumentation();
+        });
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "不插桩: " << plainMs << " 毫秒" << std::endl;
+        std::cout << "计数: " << countingMs << " 毫秒" << std::endl;
+        std::cout << "追踪: " << tracingMs << " 毫秒" << std::endl;
+        std::cout << std::setprecision(2);
+        counts.report(std::cout);
+        if (trace.saveTrace("trace.json")) {
+            std::cout << "时间线保存到: trace.json（" << trace.events.size() << " 个事件）" << std::endl;
+        }
+    }
+
+    // 剖分过程中的堆分配：一次性剖分 n 个点，再在同一剖分上移动 moves 次点（每次删除再插入），
+    // 分别统计 operator new 的次数与字节数，并报告三角形位置的复用情况与数组长度峰值
+    static void runAllocations(int n, int moves) {
+        std::cout << "\n=== 堆分配统计 (" << n << " 个点, " << moves << " 次移动) ===" << std::endl;
+        std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+        Delaunay<float, CountingInstrumentation> triangulation;
+        const AllocationCounts beforeBuild = allocationCounts();
+        const std::size_t triangleCount = triangulation.triangulateIndexed(points).triangleCount();
+        const AllocationCounts build = allocationCounts() - beforeBuild;
+        const CountingInstrumentation buildCounts = triangulation.instrumentation();
+
+        // 超级三角形在无穷远处，移出原来包围盒的点也直接删除再插入，不需要整体重建
+        const AllocationCounts beforeMoves = allocationCounts();
+        int moved = 0;
+        for (int k = 0; k < moves; ++k) {
+            const std::uint32_t v = static_cast<std::uint32_t>(gen() % points.size());
+            const Vector2<float> target(points[v].x + jitter(gen), points[v].y + jitter(gen));
+            if (triangulation.move(v, target)) {
+                points[v] = target;
+                ++moved;
+            }
+        }
+        const AllocationCounts update = allocationCounts() - beforeMoves;
+        const CountingInstrumentation& counts = triangulation.instrumentation();
+
+        std::cout << "一次性剖分: " << triangleCount << " 个三角形, " << build.allocations << " 次分配, "
+            << build.bytes / (1024.0 * 1024.0) << " MB" << std::endl;
+        std::cout << "  新建三角形 " << buildCounts.reusedFaces + buildCounts.appendedFaces << " 个，其中复用 "
+            << buildCounts.reusedFaces << " 个; 三角形数组长度峰值 " << buildCounts.peakStoredFaces << std::endl;
+        std::cout << "移动 " << moved << " 个点: " << update.allocations << " 次分配, " << update.bytes << " 字节" << std::endl;
+        std::cout << "  新建三角形 " << counts.reusedFaces + counts.appendedFaces - buildCounts.reusedFaces - buildCounts.appendedFaces
+            << " 个，其中追加到数组末尾 " << counts.appendedFaces - buildCounts.appendedFaces
+            << " 个; 三角形数组长度峰值 " << counts.peakStoredFaces << std::endl;
+    }
+
+    // 大量小点集（例如切块后的点云）：每块新建一个剖分对象，与复用同一个对象（先按最大的块 reserve，
+    // 每块用完后 reset）对比每块的耗时，以及第一块之后的分配次数
+    static void runSmallInputs(int tiles, int tileSize) {
+        std::cout << "\n=== 大量小点集 (" << tiles << " 块, 每块 " << tileSize / 2 << " 到 " << tileSize << " 个点) ===" << std::endl;
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<float> coord(0.0f, 100.0f);
+        std::uniform_int_distribution<int> size(tileSize / 2, tileSize);
+        std::vector<std::vector<Vector2<float>>> blocks(tiles);
+        for (auto& block : blocks) {
+            block.resize(size(gen));
+            for (auto& p : block) p = Vector2<float>(coord(gen), coord(gen));
+        }
+
+        const char* names[2] = { "每块新建对象", "复用对象 (reserve + reset)" };
+        std::size_t triangleCount[2] = { 0, 0 };
+        for (int reuse = 0; reuse < 2; ++reuse) {
+            Delaunay<float> shared;
+            if (reuse) shared.reserve(tileSize);
+            AllocationCounts afterFirst;
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < tiles; ++t) {
+                if (reuse) {
+                    triangleCount[reuse] += shared.triangulateIndexed(blocks[t]).triangleCount();
+                    shared.reset();
+                }
+                else {
+                    Delaunay<float> triangulation;
+                    triangleCount[reuse] += triangulation.triangulateIndexed(blocks[t]).triangleCount();
+                }
+                if (t == 0) afterFirst = allocationCounts();
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+            const AllocationCounts counts = allocationCounts() - afterFirst;
+
+            std::cout << std::fixed << std::setprecision(2);
+            std::cout << names[reuse] << ": " << std::chrono::duration<double, std::micro>(endTime - startTime).count() / tiles
+                << " 微秒/块, 第一块之后 " << counts.allocations << " 次分配, " << counts.bytes / (1024.0 * 1024.0) << " MB" << std::endl;
+        }
+        std::cout << "三角形总数" << (triangleCount[0] == triangleCount[1] ? "一致: " : "不一致: ") << triangleCount[1] << std::endl;
+    }
+
+    // 单次插入的空腔边界提取耗时：k 边形空腔，内部按扇形剖分为 k - 2 个三角形
+    // 改进前：把坏三角形的边全部放入 polygon，逐对调用 almost_equal 删除重复边
+    // 改进后：由邻接关系直接得到边界边，新三角形按边界起点编号查表连接
+    static void runCavityBoundary() {
+        std::cout << "\n=== 空腔边界提取耗时 ===" << std::endl;
+        std::cout << std::setw(8) << "空腔边数" << std::setw(16) << "改进前(ns)"
+            << std::setw(16) << "改进后(ns)" << std::setw(10) << "加速比" << std::endl;
+
+        const std::uint32_t none = 0xFFFFFFFFu;
+        const int sizes[] = { 4, 6, 8, 16, 32, 64 };
+        for (int k : sizes) {
+            // 空腔顶点均匀分布在圆上
+            std::vector<Vector2<float>> ring;
+            for (int i = 0; i < k; ++i) {
+                const double a = 6.283185307179586 * i / k;
+                ring.push_back(Vector2<float>(float(100 + 50 * std::cos(a)), float(100 + 50 * std::sin(a))));
+            }
+
+            // 扇形剖分：三角形 t = (0, t + 1, t + 2)，相邻三角形共享对角线
+            std::vector<std::uint32_t> tris, nbrs;
+            for (int t = 0; t < k - 2; ++t) {
+                tris.push_back(0); tris.push_back(t + 1); tris.push_back(t + 2);
+                nbrs.push_back(t == 0 ? none : t - 1);
+                nbrs.push_back(none);
+                nbrs.push_back(t == k - 3 ? none : t + 1);
+            }
+
+            const int rounds = std::max(2000, 400000 / (k * k));
+            std::size_t checksum = 0;
+
+            auto t0 = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < rounds; ++r) {
+                std::vector<Edge<float>> polygon;
+                for (int t = 0; t < k - 2; ++t) {
+                    const Triangle<float> tri(ring[tris[3 * t]], ring[tris[3 * t + 1]], ring[tris[3 * t + 2]]);
+                    polygon.push_back(tri.e1);
+                    polygon.push_back(tri.e2);
+                    polygon.push_back(tri.e3);
+                }
+                for (auto e1 = polygon.begin(); e1 != polygon.end(); ++e1) {
+                    for (auto e2 = e1 + 1; e2 != polygon.end(); ++e2) {
+                        if (almost_equal(*e1, *e2)) {
+                            e1->isBad = true;
+                            e2->isBad = true;
+                        }
+                    }
+                }
+                polygon.erase(std::remove_if(polygon.begin(), polygon.end(), [](Edge<float>& e) {
+                    return e.isBad;
+                    }), polygon.end());
+                checksum += polygon.size();
+            }
+            auto t1 = std::chrono::high_resolution_clock::now();
+
+            std::vector<std::uint32_t> boundary, fan(3 * k), fanStart(k, none);
+            for (int r = 0; r < rounds; ++r) {
+                boundary.clear();
+                for (int t = 0; t < k - 2; ++t) {
+                    for (int e = 0; e < 3; ++e) {
+                        if (nbrs[3 * t + e] == none) {
+                            boundary.push_back(tris[3 * t + e]);
+                            boundary.push_back(tris[3 * t + (e + 1) % 3]);
+                        }
+                    }
+                }
+                const std::size_t m = boundary.size() / 2;
+                for (std::size_t i = 0; i < m; ++i) fanStart[boundary[2 * i]] = std::uint32_t(i);
+                for (std::size_t i = 0; i < m; ++i) {
+                    const std::uint32_t j = fanStart[boundary[2 * i + 1]];
+                    fan[3 * i + 1] = j;
+                    fan[3 * j + 2] = std::uint32_t(i);
+                }
+                checksum += m;
+            }
+            auto t2 = std::chrono::high_resolution_clock::now();
+
+            // 两种方法得到的边界边数都应为 k
+            const double before = std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+            const double after = std::chrono::duration<double, std::nano>(t2 - t1).count() / rounds;
+            std::cout << std::setw(8) << k << std::setw(16) << std::fixed << std::setprecision(1) << before
+                << std::setw(16) << after << std::setw(10) << before / after
+                << (checksum == std::size_t(2) * k * rounds ? "" : "  (边界边数异常)") << std::endl;
+        }
+    }
+
+    // 外接圆检测吞吐量：每次重新计算外接圆、使用 Triangle 缓存的外接圆、SoA 批量检测三种方式对比
+    static void runInCircleThroughput() {
+        std::cout << "\n=== 外接圆检测吞吐量 ===" << std::endl;
+
+        const int circleCount = 4096;
+        const int queryCount = 2000;
+        std::mt19937 gen(12345);
+        std::uniform_real_distribution<double> dis(0, 800);
+
+        std::vector<Triangle<double>> triangles;
+        CircumCircleBlock block;
+        block.resize(circleCount);
+        for (int i = 0; i < circleCount; ++i) {
+            const Vector2<double> a(dis(gen), dis(gen)), b(dis(gen), dis(gen)), c(dis(gen), dis(gen));
+            triangles.push_back(Triangle<double>(a, b, c));
+            block.set(i, a.x, a.y, b.x, b.y, c.x, c.y);
+        }
+        std::vector<Vector2<double>> queries;
+        for (int i = 0; i < queryCount; ++i) {
+            queries.push_back(Vector2<double>(dis(gen), dis(gen)));
+        }
+
+        const double tests = double(circleCount) * queryCount;
+        std::size_t hits[3] = { 0, 0, 0 };
+
+        // 改进前：每次检测都由三个顶点重新计算圆心和半径
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (const auto& v : queries) {
+            for (const auto& t : triangles) {
+                const double ab = t.p1.norm2();
+                const double cd = t.p2.norm2();
+                const double ef = t.p3.norm2();
+                const double circum_x = (ab * (t.p3.y - t.p2.y) + cd * (t.p1.y - t.p3.y) + ef * (t.p2.y - t.p1.y)) / (t.p1.x * (t.p3.y - t.p2.y) + t.p2.x * (t.p1.y - t.p3.y) + t.p3.x * (t.p2.y - t.p1.y));
+                const double circum_y = (ab * (t.p3.x - t.p2.x) + cd * (t.p1.x - t.p3.x) + ef * (t.p2.x - t.p1.x)) / (t.p1.y * (t.p3.x - t.p2.x) + t.p2.y * (t.p1.x - t.p3.x) + t.p3.y * (t.p2.x - t.p1.x));
+                const Vector2<double> circum(half(circum_x), half(circum_y));
+                hits[0] += v.dist2(circum) <= t.p1.dist2(circum);
+            }
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        // 缓存外接圆后的逐个检测
+        for (const auto& v : queries) {
+            for (const auto& t : triangles) {
+                hits[1] += t.circumCircleContains(v);
+            }
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+
+        // SoA 批量检测
+        std::vector<std::uint8_t> inside(circleCount);
+        for (const auto& v : queries) {
+            block.containsBatch(v.x, v.y, 0, circleCount, inside.data());
+            for (int i = 0; i < circleCount; ++i) hits[2] += inside[i];
+        }
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+#if defined(CIRCUMCIRCLE_AVX2)
+        const char* isa = "AVX2";
+#elif defined(CIRCUMCIRCLE_SSE2)
+        const char* isa = "SSE2";
+#else
+        const char* isa = "标量";
+#endif
+        const double rate[3] = {
+            tests / std::chrono::duration<double, std::micro>(t1 - t0).count(),
+            tests / std::chrono::duration<double, std::micro>(t2 - t1).count(),
+            tests / std::chrono::duration<double, std::micro>(t3 - t2).count()
+        };
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "每次重新计算外接圆: " << rate[0] << " 百万次/秒, 命中 " << hits[0] << std::endl;
+        std::cout << "缓存外接圆逐个检测: " << rate[1] << " 百万次/秒, 命中 " << hits[1] << std::endl;
+        std::cout << "SoA 批量检测 (" << isa << "): " << rate[2] << " 百万次/秒, 命中 " << hits[2] << std::endl;
+        std::cout << "批量检测相对重新计算的加速比: " << rate[2] / rate[0] << std::endl;
+    }
+
+    // 并行三角剖分的强扩展性测试：点数固定，线程数从 1 增加到硬件线程数，
+    // 以串行剖分为基准计算加速比，并核对并行结果与串行结果是同一组三角形
+    static void runParallelScaling() {
+        std::cout << "\n=== 并行三角剖分强扩展性测试 ===" << std::endl;
+
+        const unsigned hardware = ThreadPool::defaultThreadCount();
+        std::vector<unsigned> threadCounts;
+        for (unsigned t = 2; t < hardware; t *= 2) threadCounts.push_back(t);
+        threadCounts.push_back(std::max(2u, hardware));
+
+        const int sizes[] = { 1000000, 10000000 };
+        for (int n : sizes) {
+            std::vector<Vector2<float>> points = FileIO::generateRandomPoints(n);
+
+            double serialMs = 0;
+            std::vector<std::array<std::uint32_t, 3>> reference;
+            {
+                auto startTime = std::chrono::high_resolution_clock::now();
+                Delaunay<float> triangulation;
+                const IndexedMesh<float>& mesh = triangulation.triangulateIndexed(points);
+                auto endTime = std::chrono::high_resolution_clock::now();
+                serialMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+                reference = sortedTriangles(mesh);
+            }
+
+            std::cout << std::setw(8) << "线程数" << std::setw(14) << "耗时(毫秒)" << std::setw(10) << "加速比"
+                << std::setw(12) << "并行效率" << "  结果" << std::endl;
+            std::cout << std::setw(8) << 1 << std::setw(14) << std::fixed << std::setprecision(1) << serialMs
+                << std::setw(10) << std::setprecision(2) << 1.0 << std::setw(12) << 1.0 << "  串行基准" << std::endl;
+
+            for (unsigned t : threadCounts) {
+                ThreadPool pool(t);
+                auto startTime = std::chrono::high_resolution_clock::now();
+                Delaunay<float> triangulation;
+                const IndexedMesh<float>& mesh = triangulation.triangulateIndexed(points, pool);
+                auto endTime = std::chrono::high_resolution_clock::now();
+                const double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+                const char* result = !triangulation.lastRunParallel() ? "退回串行"
+                    : sortedTriangles(mesh) == reference ? "与串行一致" : "与串行不一致";
+                std::cout << std::setw(8) << t << std::setw(14) << std::setprecision(1) << ms
+                    << std::setw(10) << std::setprecision(2) << serialMs / ms
+                    << std::setw(12) << serialMs / ms / t << "  " << result << std::endl;
+            }
+        }
+        if (hardware == 1) {
+            std::cout << "本机只有 1 个硬件线程，加速比只反映并行版本的额外开销" << std::endl;
+        }
+    }
+
+    // 逐个三角形检查：顶点逆时针，且每个相邻三角形的对顶点都不严格落在它的外接圆内（精确谓词）
+    static bool isDelaunay(const IndexedMesh<float>& mesh) {
+        for (std::size_t t = 0; t < mesh.triangleCount(); ++t) {
+            const Vector2<float> a = mesh.vertex(mesh.corner(t, 0));
+            const Vector2<float> b = mesh.vertex(mesh.corner(t, 1));
+            const Vector2<float> c = mesh.vertex(mesh.corner(t, 2));
+            if (predicates::orient2d(a.x, a.y, b.x, b.y, c.x, c.y) <= 0) return false;
+            for (int i = 0; i < 3; ++i) {
+                const std::uint32_t u = mesh.neighbor(t, i);
+                if (u == IndexedMesh<float>::INVALID_INDEX) continue;
+                for (int k = 0; k < 3; ++k) {
+                    const std::uint32_t v = mesh.corner(u, k);
+                    if (v == mesh.corner(t, i) || v == mesh.corner(t, (i + 1) % 3)) continue;
+                    const Vector2<float> p = mesh.vertex(v);
+                    if (predicates::incircle(a.x, a.y, b.x, b.y, c.x, c.y, p.x, p.y) > 0) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // 每个三角形把编号最小的顶点轮换到最前面后整体排序，用于比较两次剖分是否得到同一组三角形
+    static std::vector<std::array<std::uint32_t, 3>> sortedTriangles(const IndexedMesh<float>& mesh) {
+        std::vector<std::array<std::uint32_t, 3>> triangles(mesh.triangleCount());
+        for (std::size_t t = 0; t < mesh.triangleCount(); ++t) {
+            std::array<std::uint32_t, 3>& v = triangles[t];
+            v = { mesh.corner(t, 0), mesh.corner(t, 1), mesh.corner(t, 2) };
+            while (v[0] > v[1] || v[0] > v[2]) {
+                std::rotate(v.begin(), v.begin() + 1, v.end());
+            }
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+};
+
+#endif
@@ -0,0 +1,232 @@
+#pragma once
+#ifndef H_CIRCUMCIRCLE
+#define H_CIRCUMCIRCLE
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+//编译时按指令集选择批量检测的实现：开启 /arch:AVX2（或 -mavx2）时使用 AVX2，
+//x64 默认使用 SSE2，其余平台使用标量版本
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIRCUMCIRCLE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CIRCUMCIRCLE_SSE2
+#endif
+
+//由三角形顶点计算外接圆的圆心 (x, y)、半径平方 r2，以及圆心坐标的误差上界 err
+//三点共线时半径取无穷大，此时缓存的外接圆不能用于判断
+inline void computeCircumCircle(double ax, double ay, double bx, double by, double cx, double cy,
+    double& x, double& y, double& r2, double& err)
+{
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double bax = bx - ax, bay = by - ay;
+    const double cax = cx - ax, cay = cy - ay;
+    const double d = 2 * (bax * cay - bay * cax);
+    if (d == 0)
+    {
+        x = ax;
+        y = ay;
+        r2 = std::numeric_limits<double>::infinity();
+        err = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    const double b2 = bax * bax + bay * bay;
+    const double c2 = cax * cax + cay * cay;
+    const double ux = (cay * b2 - bay * c2) / d;
+    const double uy = (bax * c2 - cax * b2) / d;
+    x = ax + ux;
+    y = ay + uy;
+    r2 = ux * ux + uy * uy;
+
+    //分子、分母的舍入误差按各自的绝对值和估计，除以 |d| 后得到圆心偏移的误差；
+    //三角形越狭长，|d| 相对其绝对值和越小，误差越大
+    const double ad = std::abs(d);
+    const double numerPermanent = (std::abs(cay) + std::abs(cax)) * b2 + (std::abs(bay) + std::abs(bax)) * c2;
+    const double denomPermanent = 2 * (std::abs(bax * cay) + std::abs(bay * cax));
+    err = 8 * eps * (numerPermanent / ad + denomPermanent / ad * (std::abs(ux) + std::abs(uy)))
+        + 2 * eps * (std::abs(x) + std::abs(y));
+}
+
+//把圆心误差上界 err 换算成判断时的容差 tol = tolA * d2 + tolB，d2 为点到圆心的距离平方，
+//eps 为做判断时所用浮点类型的机器精度。由 sqrt(d2) + r <= d2 / (2r) + 1.5r 得到，判断时不需要开方
+inline void computeCircumTolerance(double r2, double err, double eps, double& tolA, double& tolB)
+{
+    if (!(r2 < std::numeric_limits<double>::infinity()))
+    {
+        tolA = tolB = std::numeric_limits<double>::infinity();
+        return;
+    }
+    const double r = std::sqrt(r2);
+    tolA = err / r + 8 * eps;
+    tolB = 3 * err * r + 8 * eps * r2;
+}
+
+//用缓存的外接圆判断点 p 的位置并给出可信度：返回 1 表示确定在圆内，-1 表示确定在圆外，
+//0 表示 p 离圆周太近，缓存值的误差不足以判断，需要调用精确谓词
+template <class T>
+int classifyCircumCircle(T x, T y, T r2, T tolA, T tolB, T px, T py)
+{
+    const T dx = px - x;
+    const T dy = py - y;
+    const T d2 = dx * dx + dy * dy;
+    const T power = d2 - r2;
+    const T tol = tolA * d2 + tolB;
+    //不用分支，圆内、圆外各占一半时也不会有分支预测失败
+    return int(power < -tol) - int(power > tol);
+}
+
+//以结构体数组（SoA）方式缓存的一组外接圆：圆心 (x, y)、半径平方 r2 与判断容差的系数 tolA、tolB
+struct CircumCircleBlock
+{
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> r2;
+    std::vector<double> tolA;
+    std::vector<double> tolB;
+
+    std::size_t size() const { return r2.size(); }
+
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        r2.clear();
+        tolA.clear();
+        tolB.clear();
+    }
+
+    void reserve(std::size_t n)
+    {
+        x.reserve(n);
+        y.reserve(n);
+        r2.reserve(n);
+        tolA.reserve(n);
+        tolB.reserve(n);
+    }
+
+    void resize(std::size_t n)
+    {
+        x.resize(n);
+        y.resize(n);
+        r2.resize(n);
+        tolA.resize(n);
+        tolB.resize(n);
+    }
+
+    //由三角形顶点计算外接圆并写入第 i 项，三点共线时半径取无穷大
+    void set(std::size_t i, double ax, double ay, double bx, double by, double cx, double cy)
+    {
+        double err;
+        computeCircumCircle(ax, ay, bx, by, cx, cy, x[i], y[i], r2[i], err);
+        computeCircumTolerance(r2[i], err, std::numeric_limits<double>::epsilon(), tolA[i], tolB[i]);
+    }
+
+    //第 i 项设为无界的“外接圆”（含超级三角形顶点的三角形）：批量检测总是返回在圆内，
+    //classify 总是返回 0，交给精确谓词判断
+    void setUnbounded(std::size_t i)
+    {
+        x[i] = y[i] = 0;
+        r2[i] = tolA[i] = tolB[i] = std::numeric_limits<double>::infinity();
+    }
+
+    //把第 from 项复制到第 to 项
+    void copy(std::size_t from, std::size_t to)
+    {
+        x[to] = x[from];
+        y[to] = y[from];
+        r2[to] = r2[from];
+        tolA[to] = tolA[from];
+        tolB[to] = tolB[from];
+    }
+
+    //把另一组外接圆的第 from 项复制到本组的第 to 项
+    void copyFrom(const CircumCircleBlock& other, std::size_t from, std::size_t to)
+    {
+        x[to] = other.x[from];
+        y[to] = other.y[from];
+        r2[to] = other.r2[from];
+        tolA[to] = other.tolA[from];
+        tolB[to] = other.tolB[from];
+    }
+
+    //单个外接圆的检测（在圆内或圆上）
+    bool contains(std::size_t i, double px, double py) const
+    {
+        const double dx = px - x[i];
+        const double dy = py - y[i];
+        return dx * dx + dy * dy <= r2[i];
+    }
+
+    //带误差界的判断，返回值含义同 classifyCircumCircle
+    int classify(std::size_t i, double px, double py) const
+    {
+        return classifyCircumCircle(x[i], y[i], r2[i], tolA[i], tolB[i], px, py);
+    }
+
+    //点 p 到第 i 个圆心的距离平方与半径平方之差，小于 0 表示在圆内
+    double power(std::size_t i, double px, double py) const
+    {
+        const double dx = px - x[i];
+        const double dy = py - y[i];
+        return dx * dx + dy * dy - r2[i];
+    }
+
+    //把 4 位比较掩码展开成 4 个字节（每字节 0 或 1）
+    static const std::uint8_t* expandMask(int mask)
+    {
+        static const std::uint8_t table[16][4] = {
+            {0,0,0,0}, {1,0,0,0}, {0,1,0,0}, {1,1,0,0}, {0,0,1,0}, {1,0,1,0}, {0,1,1,0}, {1,1,1,0},
+            {0,0,0,1}, {1,0,0,1}, {0,1,0,1}, {1,1,0,1}, {0,0,1,1}, {1,0,1,1}, {0,1,1,1}, {1,1,1,1}
+        };
+        return table[mask];
+    }
+
+    //一个点对 [first, first + count) 范围内的外接圆做批量检测，inside[k] 为 1 表示在第 first + k 个圆内
+    void containsBatch(double px, double py, std::size_t first, std::size_t count, std::uint8_t* inside) const
+    {
+        const double* cx = x.data() + first;
+        const double* cy = y.data() + first;
+        const double* rr = r2.data() + first;
+        std::size_t k = 0;
+
+#if defined(CIRCUMCIRCLE_AVX2)
+        const __m256d vpx = _mm256_set1_pd(px);
+        const __m256d vpy = _mm256_set1_pd(py);
+        for (; k + 4 <= count; k += 4)
+        {
+            const __m256d dx = _mm256_sub_pd(vpx, _mm256_loadu_pd(cx + k));
+            const __m256d dy = _mm256_sub_pd(vpy, _mm256_loadu_pd(cy + k));
+            const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+            const int mask = _mm256_movemask_pd(_mm256_cmp_pd(d2, _mm256_loadu_pd(rr + k), _CMP_LE_OQ));
+            std::memcpy(inside + k, expandMask(mask), 4);
+        }
+#elif defined(CIRCUMCIRCLE_SSE2)
+        const __m128d vpx = _mm_set1_pd(px);
+        const __m128d vpy = _mm_set1_pd(py);
+        for (; k + 2 <= count; k += 2)
+        {
+            const __m128d dx = _mm_sub_pd(vpx, _mm_loadu_pd(cx + k));
+            const __m128d dy = _mm_sub_pd(vpy, _mm_loadu_pd(cy + k));
+            const __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+            const int mask = _mm_movemask_pd(_mm_cmple_pd(d2, _mm_loadu_pd(rr + k)));
+            std::memcpy(inside + k, expandMask(mask), 2);
+        }
+#endif
+
+        for (; k < count; ++k)
+        {
+            const double dx = px - cx[k];
+            const double dy = py - cy[k];
+            inside[k] = dx * dx + dy * dy <= rr[k];
+        }
+    }
+};
+
+#endif
@@ -1,135 +1,1645 @@
+
 #ifndef H_DELAUNAY
 #define H_DELAUNAY
 
 #include "vector2.h"
+#include "point_view.h"
 #include "edge.h"
 #include "triangle.h"
+#include "mesh.h"
+#include "circumcircle.h"
+#include "super_triangle.h"
+#include "predicates.h"
+#include "thread_pool.h"
+#include "spatial_sort.h"
+#include "sweep_hull.h"
+#include "divide_conquer.h"
+#include "instrumentation.h"
 
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <unordered_map>
+#include <chrono>
+
+//整体剖分使用的算法
+enum class DelaunayEngine
+{
+    BowyerWatson,       //从超级三角形开始逐点插入（默认）
+    SweepHull,          //扫描凸包加 Lawson 翻转（见 sweep_hull.h）
+    DivideAndConquer    //Guibas–Stolfi 分治，可并行（见 divide_conquer.h）
+};
 
-template <class T>
+//Instrumentation 为插桩策略（见 instrumentation.h），默认不插桩，不产生任何额外代码
+template <class T, class Instrumentation = NoInstrumentation>
 class Delaunay
 {
 public:
     using TriangleType = Triangle<T>;
     using EdgeType = Edge<T>;
     using VertexType = Vector2<T>;
+    using MeshType = IndexedMesh<T>;
+
+    //无效索引，表示该边外侧没有相邻三角形
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    //超级三角形三个顶点的编号为 SUPER_INDEX、SUPER_INDEX + 1、SUPER_INDEX + 2，
+    //放在编号范围的顶端，增删点时不会与输入点的编号冲突。超级顶点是无穷远处的符号点（见 super_triangle.h），
+    //没有坐标，含超级顶点的谓词由 SuperTriangle 按编号计算
+    static constexpr std::uint32_t SUPER_INDEX = SuperTriangle::SUPER_INDEX;
+
+    //上一次剖分各阶段的耗时（纳秒）
+    struct PhaseTimes
+    {
+        std::int64_t bounds = 0;        //计算输入点的包围盒
+        std::int64_t superTriangle = 0; //超级三角形与定位网格
+        std::int64_t insertion = 0;     //逐点插入，含 BRIO 重排；并行模式为条带剖分与拼接，扫描凸包、分治为排序与剖分
+        std::int64_t cleanup = 0;       //剔除含超级三角形顶点的三角形，生成 Triangle 对象或索引网格
+        std::int64_t edges = 0;         //生成不重复的 Edge 对象（第一次调用 getEdges 时），不取边时为 0
+    };
+
+    //Deluanay 三角剖分核心算法  ---  逐点插入法。
+    //输入点不做拷贝：剖分直接从 points 引用的数组中读取坐标，输出的顶点编号就是点在这个数组中的编号。
+    //在下一次剖分之前，索引网格和 getVertices 都引用这个数组，调用方不能释放或修改它；
+    //第一次动态更新（insert / move）时才把坐标拷贝到内部，此后与调用方的数组无关
+    const std::vector<TriangleType>& triangulate(const PointView<T>& points)
+    {
+        insertAll(points);
+        return buildTriangles();
+    }
+
+    //索引网格模式：不生成 Triangle / Edge 对象，只输出顶点索引和邻接关系
+    const MeshType& triangulateIndexed(const PointView<T>& points)
+    {
+        insertAll(points);
+        return buildMesh();
+    }
+
+    //多线程模式：点集按 x 坐标切成与线程数相同的条带并行剖分，再重新剖分条带接缝处的点（见 insertStrips）。
+    //得到的三角形与串行模式完全相同，只是排列顺序不同
+    const std::vector<TriangleType>& triangulate(const PointView<T>& points, ThreadPool& pool)
+    {
+        insertAll(points, pool);
+        return buildTriangles();
+    }
+
+    const MeshType& triangulateIndexed(const PointView<T>& points, ThreadPool& pool)
+    {
+        insertAll(points, pool);
+        return buildMesh();
+    }
 
-    //Deluanay ʷֺ㷨  ---  뷨
+    //std::vector 与一段连续的点（例如 MappedPoints 映射的二进制点文件）同样不拷贝，按 PointView 读取
     const std::vector<TriangleType>& triangulate(std::vector<VertexType>& vertices)
     {
-        // ƿһ
-        _vertices = vertices;
+        return triangulate(PointView<T>(vertices.data(), vertices.size()));
+    }
+
+    const MeshType& triangulateIndexed(std::vector<VertexType>& vertices)
+    {
+        return triangulateIndexed(PointView<T>(vertices.data(), vertices.size()));
+    }
+
+    const std::vector<TriangleType>& triangulate(std::vector<VertexType>& vertices, ThreadPool& pool)
+    {
+        return triangulate(PointView<T>(vertices.data(), vertices.size()), pool);
+    }
+
+    const MeshType& triangulateIndexed(std::vector<VertexType>& vertices, ThreadPool& pool)
+    {
+        return triangulateIndexed(PointView<T>(vertices.data(), vertices.size()), pool);
+    }
+
+    const std::vector<TriangleType>& triangulate(const VertexType* points, std::size_t count)
+    {
+        return triangulate(PointView<T>(points, count));
+    }
+
+    const MeshType& triangulateIndexed(const VertexType* points, std::size_t count)
+    {
+        return triangulateIndexed(PointView<T>(points, count));
+    }
+
+    const MeshType& triangulateIndexed(const VertexType* points, std::size_t count, ThreadPool& pool)
+    {
+        return triangulateIndexed(PointView<T>(points, count), pool);
+    }
+
+    //清空剖分结果与输入点，回到刚构造时的状态，但保留各缓冲区已经分配的容量（插桩计数不清零）。
+    //逐块剖分大量小点集时复用同一个对象，第一块之后不再分配内存；也用于不再引用调用方的点数组
+    void reset()
+    {
+        _triangles.clear();
+        _edges.clear();
+        _edgesValid = false;
+        _hull.clear();
+        _hullNext.clear();
+        _mesh.clear();
+        _remap.clear();
+        _vertices.clear();
+        adoptVertices();
+        _phases = PhaseTimes();
+        _sweep.clear();
+        _divide.clear();
+        _superFaces = true;
+
+        _faces.clear();
+        _circles.clear();
+        _cavity.clear();
+        _polygon.clear();
+        _fanStart.clear();
+        _vertexFace.clear();
+        _freeFaces.clear();
+        _newFaces.clear();
+        _ring.clear();
+        _across.clear();
+        _lastFace = 0;
+        _parallel = false;
+        _order.clear();
+        _grid.clear();
+        _gridVertexCount = 0;
+    }
+
+    //按不超过 n 个点的剖分预先分配缓冲区。由 Euler 公式，n 个点的剖分不超过 2n 个三角形、3n 条边，
+    //连同超级三角形的顶点恰好 2n + 1 个三角形；内部数组与索引网格按此分配，之后的剖分不再扩容。
+    //Triangle / Edge 对象占用的内存是索引网格的好几倍，只在 objects 为 true（要调用 triangulate / buildTriangles）时预留
+    void reserve(std::size_t n, bool objects = false)
+    {
+        _faces.reserve(2 * n + 1);
+        _circles.reserve(2 * n + 1);
+        _remap.reserve(2 * n + 1);
+        _fanStart.reserve(n + 3);
+        _vertexFace.reserve(n);
+        _hull.reserve(n);
+        _hullNext.reserve(n);
+        _mesh.triangles.reserve(6 * n);
+        _mesh.neighbors.reserve(6 * n);
+        if (objects)
+        {
+            _triangles.reserve(2 * n);
+            _edges.reserve(3 * n);
+        }
+        if (_engine == DelaunayEngine::SweepHull) _sweep.reserve(n);
+        if (_engine == DelaunayEngine::DivideAndConquer) _divide.reserve(n);
+
+        //插入一个点的空腔通常只有几个三角形，先留出足够的余量
+        _cavity.reserve(64);
+        _polygon.reserve(64);
+        _newFaces.reserve(64);
+        _freeFaces.reserve(64);
+
+        //定位网格约 n / 8 格，按点集的长宽比取整后不超过它的 3 倍
+        _grid.reserve(3 * (n / 8 + 1) + 1);
+    }
+
+    const std::vector<TriangleType>& getTriangles() const { return _triangles; }
+
+    //剖分的边，每条边只出现一次：内部边由编号较小的一侧三角形给出，凸包边直接给出，n 个点不超过 3n 条。
+    //由三角形的邻接关系直接去重，不需要排序或哈希。第一次调用时才生成，不取边的调用方没有额外开销；
+    //剖分或动态更新之后再调用时按当前的剖分重新生成
+    const std::vector<EdgeType>& getEdges()
+    {
+        if (_edgesValid) return _edges;
+        Clock::time_point mark = Clock::now();
+        _edges.clear();
+        _edges.reserve(3 * _points.size());
+        for (std::uint32_t i = 0; i < _faces.size(); ++i)
+        {
+            const Face& f = _faces[i];
+            if (!isInputFace(f)) continue;
+            for (int e = 0; e < 3; ++e)
+            {
+                const std::uint32_t n = f.n[e];
+                if (n == INVALID_INDEX || n > i || !isInputFace(_faces[n]))
+                    _edges.push_back(EdgeType(point(f.v[e]), point(f.v[(e + 1) % 3])));
+            }
+        }
+        _edgesValid = true;
+        _phases.edges = lap(mark, "edges");
+        return _edges;
+    }
+
+    const PointView<T>& getVertices() const { return _points; }
+    const MeshType& getMesh() const { return _mesh; }
+    const std::vector<std::uint32_t>& getConvexHull() const { return _hull; }
+
+    //插入前是否按 BRIO / Hilbert 曲线重排点（默认关闭，按输入顺序插入）。重排只影响插入顺序，
+    //输出的三角形仍使用输入编号；有完全重合的点时保留的可能是另一个编号
+    void setSpatialSort(bool enabled) { _spatialSort = enabled; }
+    bool spatialSort() const { return _spatialSort; }
+
+    //整体剖分使用的算法，默认逐点插入。扫描凸包、分治得到的剖分只含输入三角形，与逐点插入的结果相同
+    //（四点共圆时对角线可能不同）；之后第一次动态更新或点定位时才补上超级三角形（见 attachSuperTriangle）。
+    //扫描凸包没有并行版本，传入的线程池不使用；分治在线程池中并行递归。
+    //点全部共线或排序误差使扫描失败时退回逐点插入
+    void setEngine(DelaunayEngine engine) { _engine = engine; }
+    DelaunayEngine engine() const { return _engine; }
+
+    //上一次剖分的插入顺序：第 k 项是第 k 个插入的点的输入编号，未重排、由条带并行或其他算法完成时为空
+    const std::vector<std::uint32_t>& getInsertionOrder() const { return _order; }
+
+    //上一次剖分是否由条带并行（或并行的分治）完成；点数太少、线程池只有一个线程或检测到共圆等退化情况时退回串行插入
+    bool lastRunParallel() const { return _parallel; }
+
+    const PhaseTimes& lastPhaseTimes() const { return _phases; }
+
+    //插桩策略对象，计数在多次剖分之间累计
+    Instrumentation& instrumentation() { return _instr; }
+    const Instrumentation& instrumentation() const { return _instr; }
+
+    //动态更新：在已有剖分上插入、删除、移动单个点，只修改受影响的局部三角形。
+    //点的编号在整个生命周期内保持不变，删除的编号不再复用。更新后调用 buildMesh / buildTriangles 取得新的结果
+
+    //插入一个点，返回它的编号；与已有顶点重合时不插入，返回那个顶点的编号。
+    //超级三角形在无穷远处，任何位置的点都可以直接插入，不需要整体重建
+    std::uint32_t insert(const VertexType& p)
+    {
+        attachSuperTriangle();
+        _edgesValid = false;
+        ownVertices();
+        const std::uint32_t id = static_cast<std::uint32_t>(_vertices.size());
+        _vertices.push_back(p);
+        adoptVertices();
+        _fanStart.resize(_vertices.size() + 3, INVALID_INDEX);
+        _vertexFace.resize(_vertices.size(), INVALID_INDEX);
+        if (_faces.empty())
+        {
+            rebuild(id);
+            return id;
+        }
+
+        const std::uint32_t v = insertVertex(id);
+        if (v != id)
+        {
+            _vertices.pop_back();
+            adoptVertices();
+        }
+        else if (_vertices.size() > 2 * _gridVertexCount) rebuildGrid();
+        return v;
+    }
+
+    //删除编号为 v 的点，周围的空洞按 Delaunay 准则重新剖分；v 不在剖分中（已删除或是重合点）时返回 false
+    bool remove(std::uint32_t v)
+    {
+        attachSuperTriangle();
+        if (v >= _points.size() || _faces.empty() || !isVertex(v)) return false;
+        _edgesValid = false;
+        const std::uint32_t f = _vertexFace[v];
+        removeVertex(f, _faces[f].v[0] == v ? 0 : _faces[f].v[1] == v ? 1 : 2);
+        return true;
+    }
+
+    //把编号为 v 的点移动到 p，编号不变；v 不在剖分中，或 p 与其他顶点重合（v 被合并掉）时返回 false
+    bool move(std::uint32_t v, const VertexType& p)
+    {
+        if (!remove(v)) return false;
+        ownVertices();
+        _vertices[v] = p;
+        return insertVertex(v) == v;
+    }
+
+    //点定位：找到包含 p 的三角形，corners 中返回其逆时针顶点编号；p 不在剖分范围内时返回 false
+    bool findTriangle(const VertexType& p, std::uint32_t corners[3])
+    {
+        attachSuperTriangle();
+        if (_faces.empty()) return false;
+        const Face& f = _faces[locate(p)];
+        for (int k = 0; k < 3; ++k) corners[k] = f.v[k];
+        return f.v[0] < SUPER_INDEX && f.v[1] < SUPER_INDEX && f.v[2] < SUPER_INDEX;
+    }
+
+    //由当前的剖分生成 Triangle 对象，含超级三角形顶点的三角形不输出；边由 getEdges 按需生成
+    const std::vector<TriangleType>& buildTriangles()
+    {
+        Clock::time_point mark = Clock::now();
+        _triangles.clear();
+        _triangles.reserve(_faces.size());
+
+        //超级三角形的顶点按编号识别，在还原 Triangle 对象的同一遍中直接跳过，
+        //不再按坐标近似比较，靠近超级三角形顶点的真实三角形也不会被误删
+        for (const auto& f : _faces)
+        {
+            if (isInputFace(f))
+                _triangles.push_back(TriangleType(point(f.v[0]), point(f.v[1]), point(f.v[2])));
+        }
+        _phases.cleanup = lap(mark, "cleanup");
+
+        return _triangles;
+    }
+
+    //由当前的剖分生成索引网格，含超级三角形顶点的三角形不输出。
+    //顶点数组包含已删除的编号，它们不出现在任何三角形中
+    const MeshType& buildMesh()
+    {
+        Clock::time_point mark = Clock::now();
+
+        //含超级三角形顶点的三角形按编号直接剔除，其余重新连续编号
+        std::vector<std::uint32_t>& remap = _remap;
+        remap.assign(_faces.size(), INVALID_INDEX);
+        std::uint32_t count = 0;
+        for (std::uint32_t i = 0; i < _faces.size(); ++i)
+        {
+            if (isInputFace(_faces[i])) remap[i] = count++;
+        }
+
+        _mesh.clear();
+        _mesh.vertices = _points;
+        _mesh.vertexCount = _points.size();
+        _mesh.triangles.reserve(3 * count);
+        _mesh.neighbors.reserve(3 * count);
+        for (std::uint32_t i = 0; i < _faces.size(); ++i)
+        {
+            if (remap[i] == INVALID_INDEX) continue;
+            const Face& f = _faces[i];
+            for (int e = 0; e < 3; ++e)
+            {
+                _mesh.triangles.push_back(f.v[e]);
+                _mesh.neighbors.push_back(f.n[e] == INVALID_INDEX ? INVALID_INDEX : remap[f.n[e]]);
+            }
+        }
+        _phases.cleanup = lap(mark, "cleanup");
+
+        return _mesh;
+    }
+
+    //由当前的剖分生成凸包：输入点的编号，从最左（x 相同时取 y 最小）的点开始逆时针排列，凸包边上共线的点也在其中。
+    //凸包边就是一侧为输入三角形、另一侧为超级三角形（或没有三角形）的边，只需检查编号，不做几何计算；
+    //超级顶点在无穷远处，剩下的输入三角形正好铺满凸包。所有点共线（没有三角形）时为空
+    const std::vector<std::uint32_t>& buildConvexHull()
+    {
+        _hull.clear();
+        std::vector<std::uint32_t>& next = _hullNext;
+        next.assign(_points.size(), INVALID_INDEX);
+        std::uint32_t start = INVALID_INDEX;
+        for (const auto& f : _faces)
+        {
+            if (!isInputFace(f)) continue;
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.n[e] != INVALID_INDEX && isInputFace(_faces[f.n[e]])) continue;
+                const std::uint32_t a = f.v[e];
+                next[a] = f.v[(e + 1) % 3];
+                if (start == INVALID_INDEX || _points.x(a) < _points.x(start)
+                    || (_points.x(a) == _points.x(start) && _points.y(a) < _points.y(start)))
+                    start = a;
+            }
+        }
+        if (start == INVALID_INDEX) return _hull;
+
+        //每个凸包顶点恰好是一条凸包边的起点，沿 next 走一圈
+        std::uint32_t v = start;
+        do
+        {
+            _hull.push_back(v);
+            v = next[v];
+        } while (v != start && v != INVALID_INDEX && _hull.size() <= _points.size());
+        return _hull;
+    }
+
+private:
+    //以顶点索引表示的内部三角形（逆时针），n[i] 为边 (v[i], v[i+1]) 外侧的相邻三角形
+    struct Face
+    {
+        std::uint32_t v[3];
+        std::uint32_t n[3];
+        bool isBad;
+    };
+
+    //空腔边界上的一条边，outer 为边外侧仍然保留的三角形
+    struct BoundaryEdge
+    {
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t outer;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    //阶段 name 结束：返回从 mark 到现在的纳秒数，并把 mark 移到现在，用于依次记录相邻的阶段
+    std::int64_t lap(Clock::time_point& mark, const char* name)
+    {
+        const Clock::time_point now = Clock::now();
+        _instr.phase(name, mark, now);
+        const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark).count();
+        mark = now;
+        return ns;
+    }
+
+    //有效且三个顶点都是输入点的三角形
+    static bool isInputFace(const Face& f)
+    {
+        return !f.isBad && f.v[0] < SUPER_INDEX && f.v[1] < SUPER_INDEX && f.v[2] < SUPER_INDEX;
+    }
+
+    static Face makeFace(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+    {
+        Face f;
+        f.v[0] = a; f.v[1] = b; f.v[2] = c;
+        f.n[0] = f.n[1] = f.n[2] = INVALID_INDEX;
+        f.isBad = false;
+        return f;
+    }
+
+    //从超级三角形开始依次插入所有点，结果保存在 _faces 中；坐标直接从 points 读取
+    void insertAll(const PointView<T>& points)
+    {
+        Clock::time_point mark = Clock::now();
+        _phases = PhaseTimes();
+        usePoints(points);
+        _parallel = false;
+
+        T minX, minY, maxX, maxY;
+        computeBounds(_points, minX, minY, maxX, maxY);
+        _phases.bounds = lap(mark, "bounds");
+        if (_engine != DelaunayEngine::BowyerWatson && runEngine(mark, nullptr)) return;
+        insertVertices(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    //多线程版本，条带剖分不成功时退回串行插入
+    void insertAll(const PointView<T>& points, ThreadPool& pool)
+    {
+        if (_engine == DelaunayEngine::SweepHull)
+        {
+            insertAll(points);
+            return;
+        }
+        Clock::time_point mark = Clock::now();
+        _phases = PhaseTimes();
+        usePoints(points);
+        _order.clear();
 
-        // 㳬εһЩ
-        T minX = vertices[0].x;
-        T minY = vertices[0].y;
-        T maxX = minX;
-        T maxY = minY;
+        T minX, minY, maxX, maxY;
+        computeBounds(_points, minX, minY, maxX, maxY);
+        _phases.bounds = lap(mark, "bounds");
+        if (_engine == DelaunayEngine::DivideAndConquer)
+        {
+            if (runEngine(mark, &pool)) return;
+            _parallel = false;
+        }
+        else
+        {
+            _parallel = insertStrips(pool, minX, minY, maxX, maxY);
+            _phases.insertion = lap(mark, "strips");
+        }
+        if (!_parallel) insertVertices(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    //剖分调用方的点：只记下视图，内部的坐标不再使用
+    void usePoints(const PointView<T>& points)
+    {
+        _points = points;
+        _ownPoints = false;
+        _vertices.clear();
+        _edgesValid = false;
+        _superFaces = true;
+    }
 
-        //㳬εұ߽
+    //用扫描凸包或分治剖分 _points，结果换成只含输入三角形的 _faces；失败时返回 false，由调用方改用逐点插入
+    bool runEngine(Clock::time_point& mark, ThreadPool* pool)
+    {
+        _order.clear();
+        _parallel = false;
+        if (_engine == DelaunayEngine::SweepHull)
+        {
+            if (!_sweep.triangulate(_points)) return false;
+            importFaces(_sweep.triangles, _sweep.halfedges);
+            _phases.insertion = lap(mark, "sweep_hull");
+        }
+        else
+        {
+            if (!_divide.triangulate(_points, pool)) return false;
+            _parallel = _divide.lastRunParallel();
+            importFaces(_divide.triangles, _divide.halfedges);
+            _phases.insertion = lap(mark, "divide_conquer");
+        }
+        return true;
+    }
+
+    //由半边数组生成 _faces：半边 3t + i 就是三角形 t 的边 (v[i], v[i + 1])，反向半边所在的三角形就是相邻三角形。
+    //结果没有超级三角形，也不缓存外接圆，插入用的辅助结构都是空的
+    void importFaces(const std::vector<std::uint32_t>& triangles, const std::vector<std::uint32_t>& halfedges)
+    {
+        _faces.resize(triangles.size() / 3);
+        for (std::size_t t = 0; t < _faces.size(); ++t)
+        {
+            Face& f = _faces[t];
+            for (int e = 0; e < 3; ++e)
+            {
+                const std::uint32_t h = halfedges[3 * t + e];
+                f.v[e] = triangles[3 * t + e];
+                f.n[e] = h == INVALID_INDEX ? INVALID_INDEX : h / 3;
+            }
+            f.isBad = false;
+        }
+        _circles.clear();
+        _freeFaces.clear();
+        _fanStart.clear();
+        _vertexFace.clear();
+        _grid.clear();
+        _gridVertexCount = 0;
+        _lastFace = 0;
+        _superFaces = false;
+    }
+
+    //把其他算法得到的剖分接到超级三角形上，恢复动态更新与点定位所需的全部结构。
+    //先只插入凸包上的点：其余的点都在凸包内，不在含超级顶点的三角形的外接圆中，
+    //所以这样得到的含超级顶点的三角形与插入全部点时相同；再把其中的输入三角形换成原来的剖分，沿凸包边接好邻接关系
+    void attachSuperTriangle()
+    {
+        if (_superFaces) return;
+        _superFaces = true;
+        std::vector<Face> inner;
+        inner.swap(_faces);
+
+        //boundary[v] 为以 v 为起点的凸包边所在的三角形
+        const std::uint32_t n = static_cast<std::uint32_t>(_points.size());
+        std::vector<std::uint32_t> boundary(n, INVALID_INDEX);
+        for (std::uint32_t i = 0; i < inner.size(); ++i)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                if (inner[i].n[e] == INVALID_INDEX) boundary[inner[i].v[e]] = i;
+            }
+        }
+
+        T minX, minY, maxX, maxY;
+        computeBounds(_points, minX, minY, maxX, maxY);
+        resetFaces(minX, minY, maxX - minX, maxY - minY);
+        for (std::uint32_t v = 0; v < n; ++v)
+        {
+            if (boundary[v] != INVALID_INDEX) insertVertex(v);
+        }
+        for (std::uint32_t i = 0; i < _faces.size(); ++i)
+        {
+            if (isInputFace(_faces[i]))
+            {
+                _faces[i].isBad = true;
+                _freeFaces.push_back(i);
+            }
+        }
+
+        std::vector<std::uint32_t>& remap = _remap;
+        remap.resize(inner.size());
+        for (std::uint32_t i = 0; i < inner.size(); ++i)
+        {
+            remap[i] = addFace(makeFace(inner[i].v[0], inner[i].v[1], inner[i].v[2]));
+        }
+        for (std::uint32_t i = 0; i < inner.size(); ++i)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                if (inner[i].n[e] != INVALID_INDEX) _faces[remap[i]].n[e] = remap[inner[i].n[e]];
+            }
+        }
+
+        //含超级顶点的三角形上两端都是输入点的边 (a, b)，另一侧是以 b 为起点的凸包边 (b, a)
+        for (std::uint32_t s = 0; s < _faces.size(); ++s)
+        {
+            Face& f = _faces[s];
+            if (f.isBad || isInputFace(f)) continue;
+            for (int e = 0; e < 3; ++e)
+            {
+                const std::uint32_t a = f.v[e];
+                const std::uint32_t b = f.v[(e + 1) % 3];
+                if (a >= SUPER_INDEX || b >= SUPER_INDEX || boundary[b] == INVALID_INDEX) continue;
+                const std::uint32_t fi = remap[boundary[b]];
+                Face& g = _faces[fi];
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (g.v[k] == b && g.v[(k + 1) % 3] == a)
+                    {
+                        f.n[e] = fi;
+                        g.n[k] = s;
+                    }
+                }
+            }
+        }
+        _lastFace = remap.empty() ? 0 : remap[0];
+        rebuildGrid();
+    }
+
+    //改为从内部的 _vertices 读取坐标，_vertices 改变大小后都要重新调用
+    void adoptVertices()
+    {
+        _points = PointView<T>(_vertices.data(), _vertices.size());
+        _ownPoints = true;
+    }
+
+    //动态更新需要修改坐标：坐标还在调用方的数组中时先拷贝一份
+    void ownVertices()
+    {
+        if (_ownPoints) return;
+        std::vector<VertexType> vertices(_points.size());
+        for (std::size_t i = 0; i < vertices.size(); ++i) vertices[i] = _points[i];
+        _vertices.swap(vertices);
+        adoptVertices();
+    }
+
+    //计算点集的上下左右边界
+    static void computeBounds(const PointView<T>& vertices, T& minX, T& minY, T& maxX, T& maxY)
+    {
+        minX = vertices.x(0);
+        minY = vertices.y(0);
+        maxX = minX;
+        maxY = minY;
         for (std::size_t i = 0; i < vertices.size(); ++i)
         {
-            if (vertices[i].x < minX) minX = vertices[i].x;
-            if (vertices[i].y < minY) minY = vertices[i].y;
-            if (vertices[i].x > maxX) maxX = vertices[i].x;
-            if (vertices[i].y > maxY) maxY = vertices[i].y;
+            const T x = vertices.x(i);
+            const T y = vertices.y(i);
+            if (x < minX) minX = x;
+            if (y < minY) minY = y;
+            if (x > maxX) maxX = x;
+            if (y > maxY) maxY = y;
+        }
+    }
+
+    //从超级三角形开始，依次插入 _points 中的每个点
+    void insertVertices(T minX, T minY, T dx, T dy)
+    {
+        const std::uint32_t n = static_cast<std::uint32_t>(_points.size());
+
+        //按 BRIO 顺序重排点，插入时相邻编号的点在空间上靠近；插入完成后把顶点编号换回输入编号。
+        //重排后的坐标是插入期间唯一的一份拷贝，插入完成后释放，仍从 input 读取
+        Clock::time_point mark = Clock::now();
+        const PointView<T> input = _points;
+        std::vector<VertexType> sorted;
+        _order.clear();
+        if (_spatialSort)
+        {
+            _order = brioOrder(input);
+            sorted.resize(n);
+            for (std::uint32_t k = 0; k < n; ++k) sorted[k] = input[_order[k]];
+            _points = PointView<T>(sorted.data(), n);
+        }
+
+        _phases.insertion += lap(mark, "spatial_sort");
+        resetFaces(minX, minY, dx, dy);
+        _phases.superTriangle += lap(mark, "reset_faces");
+
+        //开始依次插入每个点，每次只访问空腔内的三角形
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            insertVertex(i);
         }
 
-        const T dx = maxX - minX;
-        const T dy = maxY - minY;
-        const T deltaMax = std::max(dx, dy);
-        const T midx = half(minX + maxX);
-        const T midy = half(minY + maxY);
+        if (_spatialSort)
+        {
+            for (auto& f : _faces)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    if (f.v[e] < n) f.v[e] = _order[f.v[e]];
+                }
+            }
+            _points = input;
 
-        //󳬼ηΧȡ20
-        const VertexType p1(midx - 20 * deltaMax, midy - deltaMax);
-        const VertexType p2(midx, midy + 20 * deltaMax);
-        const VertexType p3(midx + 20 * deltaMax, midy - deltaMax);
+            std::vector<std::uint32_t> vertexFace(n);
+            for (std::uint32_t k = 0; k < n; ++k) vertexFace[_order[k]] = _vertexFace[k];
+            _vertexFace.swap(vertexFace);
+            for (auto& v : _grid)
+            {
+                if (v != INVALID_INDEX) v = _order[v];
+            }
+        }
+        _phases.insertion += lap(mark, "insertion");
+    }
 
-        //std::cout << "Super triangle " << std::endl << Triangle(p1, p2, p3) << std::endl;
+    //只保留超级三角形，清空插入用的辅助结构
+    void resetFaces(T minX, T minY, T dx, T dy)
+    {
+        //n 个点的剖分（连同超级三角形的顶点）恰好有 2n + 1 个三角形，失效的位置随即被复用，
+        //预先分配好之后插入过程中不再扩容
+        _faces.clear();
+        _circles.clear();
+        _freeFaces.clear();
+        _faces.reserve(2 * _points.size() + 1);
+        _circles.reserve(2 * _points.size() + 1);
+        addFace(makeFace(SUPER_INDEX, SUPER_INDEX + 1, SUPER_INDEX + 2));
+        _fanStart.assign(_points.size() + 3, INVALID_INDEX);
+        _vertexFace.assign(_points.size(), INVALID_INDEX);
+        _lastFace = 0;
+        initGrid(minX, minY, dx, dy);
+    }
+
+    //按仍在剖分中的点（加上 extra）整体重建，点的编号不变；定位网格按这些点的范围重新建立
+    void rebuild(std::uint32_t extra)
+    {
+        std::vector<std::uint8_t> keep(_points.size(), 0);
+        for (const auto& f : _faces)
+        {
+            if (f.isBad) continue;
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.v[e] < SUPER_INDEX) keep[f.v[e]] = 1;
+            }
+        }
+        keep[extra] = 1;
+
+        const VertexType first = _points[extra];
+        T minX = first.x, minY = first.y, maxX = first.x, maxY = first.y;
+        for (std::size_t i = 0; i < _points.size(); ++i)
+        {
+            if (!keep[i]) continue;
+            minX = std::min(minX, _points.x(i));
+            minY = std::min(minY, _points.y(i));
+            maxX = std::max(maxX, _points.x(i));
+            maxY = std::max(maxY, _points.y(i));
+        }
+        resetFaces(minX, minY, maxX - minX, maxY - minY);
+        for (std::uint32_t i = 0; i < _points.size(); ++i)
+        {
+            if (keep[i]) insertVertex(i);
+        }
+    }
+
+    //点数比建网格时翻了一倍后按当前点数重建定位网格，每格仍只有几个点
+    void rebuildGrid()
+    {
+        initGrid(T(_gridMinX), T(_gridMinY), T(_gridW / _gridInvCell), T(_gridH / _gridInvCell));
+        for (std::uint32_t v = 0; v < _vertexFace.size(); ++v)
+        {
+            if (isVertex(v))
+            {
+                const VertexType p = _points[v];
+                _grid[cellY(p) * _gridW + cellX(p)] = v;
+            }
+        }
+    }
 
-        // Create a list of triangles, and add the supertriangle in it
-        // _triangles
-        _triangles.push_back(TriangleType(p1, p2, p3));
+    //删除三角形 f 的第 corner 个顶点 v：v 周围的三角形组成一个星形多边形，
+    //反复切下一个凸的、外接圆内没有多边形其他顶点的“耳朵”（它一定是 Delaunay 三角形），直到剩下最后一个三角形
+    void removeVertex(std::uint32_t f0, int corner)
+    {
+        const std::uint32_t v = _faces[f0].v[corner];
+        const VertexType p = _points[v];
 
-        //ʼαÿ
-        for (auto p = begin(vertices); p != end(vertices); p++)
+        //绕 v 逆时针一周，记下星形区域的三角形与多边形的边；多边形第 i 条边为 (a, b)，outer 为边外侧的三角形
+        _cavity.clear();
+        _polygon.clear();
+        std::uint32_t f = f0;
+        int c = corner;
+        do
         {
-            //std::cout << "Traitement du point " << *p << std::endl;
-            //std::cout << "_triangles contains " << _triangles.size() << " elements" << std::endl;
+            const Face& face = _faces[f];
+            _cavity.push_back(f);
+            _polygon.push_back(BoundaryEdge{ face.v[(c + 1) % 3], face.v[(c + 2) % 3], face.n[(c + 1) % 3] });
+            const std::uint32_t g = face.n[(c + 2) % 3];
+            c = _faces[g].v[0] == v ? 0 : _faces[g].v[1] == v ? 1 : 2;
+            f = g;
+        } while (f != f0);
 
-            //洢ʱ²ı
-            std::vector<EdgeType> polygon;
+        for (const std::uint32_t fi : _cavity) _faces[fi].isBad = true;
+        releaseCavity();
 
-            //α _triangles  еÿ
-            for (auto& t : _triangles)
+        //ring 为多边形当前剩下的顶点（_polygon 中的位置），across[i] 为边 (ring[i], ring[i + 1]) 外侧的三角形及其边号
+        const std::size_t k = _polygon.size();
+        auto& ring = _ring;
+        auto& across = _across;
+        ring.resize(k);
+        across.resize(k);
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            //v 与两个超级三角形顶点相邻时，多边形含有超级三角形的一条边，外侧没有三角形
+            const BoundaryEdge& be = _polygon[i];
+            int e = -1;
+            if (be.outer != INVALID_INDEX)
             {
-                //std::cout << "Processing " << std::endl << *t << std::endl;
+                const Face& o = _faces[be.outer];
+                e = o.v[0] == be.b ? 0 : o.v[1] == be.b ? 1 : 2;
+            }
+            ring[i] = static_cast<std::uint32_t>(i);
+            across[i] = std::make_pair(be.outer, e);
+        }
 
-                if (t.circumCircleContains(*p))  // pôҪµ3
+        //新三角形的边 e 与外侧三角形互相连接
+        auto link = [this](std::uint32_t fi, int e, const std::pair<std::uint32_t, int>& outer) {
+            _faces[fi].n[e] = outer.first;
+            if (outer.first != INVALID_INDEX) _faces[outer.first].n[outer.second] = fi;
+        };
+
+        std::uint32_t first = INVALID_INDEX;
+        std::size_t i = 0;
+        std::size_t failures = 0;
+        while (ring.size() > 3)
+        {
+            const std::size_t m = ring.size();
+            const std::size_t prev = (i + m - 1) % m;
+            const std::size_t next = (i + 1) % m;
+            const std::uint32_t a = _polygon[ring[prev]].a;
+            const std::uint32_t b = _polygon[ring[i]].a;
+            const std::uint32_t d = _polygon[ring[next]].a;
+
+            //多边形的顶点可能是超级顶点，按编号调用符号化的谓词
+            bool ear = SuperTriangle::orient(_points, a, b, d) > 0;
+            for (std::size_t j = 0; j < m && ear; ++j)
+            {
+                if (j == prev || j == i || j == next) continue;
+                const std::uint32_t q = _polygon[ring[j]].a;
+                ear = SuperTriangle::inCircle(_points, a, b, d, q) <= 0;
+            }
+            if (!ear)
+            {
+                //谓词是精确的，星形多边形总有满足条件的耳朵；这里只作为保险，绕了一整圈仍找不到时整体重建
+                if (++failures > m)
                 {
-                    //std::cout << "Pushing bad triangle " << *t << std::endl;
-                    t.isBad = true;  //flag ı䣬׼ _triangles  н޳
-                    polygon.push_back(t.e1);
-                    polygon.push_back(t.e2);
-                    polygon.push_back(t.e3);
+                    rebuild(v);
+                    remove(v);
+                    return;
                 }
-                else
+                i = next;
+                continue;
+            }
+            failures = 0;
+
+            //切下耳朵 (prev, i, next)，它的边 2 成为多边形的新边 (prev, next)
+            const std::uint32_t fi = addFace(makeFace(_polygon[ring[prev]].a, _polygon[ring[i]].a, _polygon[ring[next]].a));
+            if (first == INVALID_INDEX) first = fi;
+            link(fi, 0, across[prev]);
+            link(fi, 1, across[i]);
+            across[prev] = std::make_pair(fi, 2);
+            ring.erase(ring.begin() + i);
+            across.erase(across.begin() + i);
+            i = prev < i ? prev : prev - 1;
+        }
+
+        const std::uint32_t fi = addFace(makeFace(_polygon[ring[0]].a, _polygon[ring[1]].a, _polygon[ring[2]].a));
+        if (first == INVALID_INDEX) first = fi;
+        link(fi, 0, across[0]);
+        link(fi, 1, across[1]);
+        link(fi, 2, across[2]);
+
+        _lastFace = first;
+        for (int e = 0; e < 3; ++e)
+        {
+            if (_faces[first].v[e] < SUPER_INDEX) _grid[cellY(p) * _gridW + cellX(p)] = _faces[first].v[e];
+        }
+    }
+
+    //点数少于此值时不切分条带，并行的额外开销得不偿失
+    static constexpr std::size_t PARALLEL_MIN_POINTS = 1u << 15;
+
+    //条带剖分中的一个条带：按输入顺序排列的点编号、点的边界、左右相邻条带中最近的 x 坐标，
+    //以及外接圆严格落在 (left, right) 之内的三角形（条带剖分中的编号）
+    struct Strip
+    {
+        std::vector<std::uint32_t> index;
+        T minX, minY, maxX, maxY;
+        double left;
+        double right;
+        std::vector<std::uint32_t> safe;
+        std::size_t used;
+    };
+
+    //校验空圆用的点网格，每个格子里的点编号连续存放，建好后只读，可以被多个线程同时查询
+    struct PointGrid
+    {
+        std::vector<std::uint32_t> start;
+        std::vector<std::uint32_t> points;
+        std::size_t w;
+        std::size_t h;
+        double minX;
+        double minY;
+        double cell;
+        double invCell;
+        double pad;
+    };
+
+    //条带并行剖分。点按 x 坐标切成点数相近的条带，各条带独立剖分：
+    //  1. 外接圆严格落在条带 x 范围内的三角形不可能包含其他条带的点，一定属于整体剖分，直接保留；
+    //  2. 其余三角形的顶点（接缝点）连同超级三角形重新剖分一次，每个三角形都用精确谓词
+    //     对全体点检查外接圆是否为空，通过的才保留。整个点集的凸包顶点都在条带的凸包上，一定是接缝点，
+    //     因此接缝剖分中含超级顶点的三角形与整体剖分相同，直接保留；
+    //  3. 两部分按公共边重新连接。
+    //点集处于一般位置时（没有四点共圆）Delaunay 剖分唯一，结果与串行插入完全相同。
+    //发现四点共圆（此时串行结果依赖插入顺序）、三角形总数不等于 2n + 1 或公共边对不上时返回 false，
+    //由调用方退回串行插入
+    bool insertStrips(ThreadPool& pool, T minX, T minY, T maxX, T maxY)
+    {
+        const std::size_t n = _points.size();
+        const std::size_t k = pool.size();
+        if (k < 2 || n < PARALLEL_MIN_POINTS || !(maxX > minX)) return false;
+
+        //按 x 坐标分桶，再按累计点数把相邻的桶合成条带；x 相同的点总在同一个桶里
+        const std::size_t bucketCount = 1024 * k;
+        const double scale = bucketCount / (double(maxX) - double(minX));
+        std::vector<std::uint32_t> bucketStrip(bucketCount);
+        auto bucketOf = [&](const VertexType& p) {
+            return std::min(static_cast<std::size_t>((p.x - double(minX)) * scale), bucketCount - 1);
+        };
+        auto stripOf = [&](std::uint32_t v) { return bucketStrip[bucketOf(_points[v])]; };
+
+        std::vector<std::size_t> stripSize(k, 0);
+        {
+            std::vector<std::size_t> bucketSize(bucketCount, 0);
+            for (std::size_t i = 0; i < n; ++i) ++bucketSize[bucketOf(_points[i])];
+
+            std::size_t s = 0;
+            std::size_t count = 0;
+            for (std::size_t b = 0; b < bucketCount; ++b)
+            {
+                bucketStrip[b] = static_cast<std::uint32_t>(s);
+                stripSize[s] += bucketSize[b];
+                count += bucketSize[b];
+                if (s + 1 < k && count * k >= (s + 1) * n) ++s;
+            }
+        }
+
+        //去掉没有点的条带
+        std::vector<std::uint32_t> remap(k);
+        std::size_t m = 0;
+        for (std::size_t s = 0; s < k; ++s)
+        {
+            remap[s] = static_cast<std::uint32_t>(std::min(m, k - 1));
+            if (stripSize[s] > 0) ++m;
+        }
+        if (m < 2) return false;
+        for (auto& s : bucketStrip) s = remap[s];
+
+        std::vector<Strip> strips(m);
+        for (std::size_t s = 0; s < k; ++s)
+        {
+            if (stripSize[s] > 0) strips[remap[s]].index.reserve(stripSize[s]);
+        }
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const VertexType p = _points[i];
+            Strip& strip = strips[stripOf(i)];
+            if (strip.index.empty())
+            {
+                strip.minX = strip.maxX = p.x;
+                strip.minY = strip.maxY = p.y;
+            }
+            strip.minX = std::min(strip.minX, p.x);
+            strip.minY = std::min(strip.minY, p.y);
+            strip.maxX = std::max(strip.maxX, p.x);
+            strip.maxY = std::max(strip.maxY, p.y);
+            strip.index.push_back(i);
+        }
+        for (std::size_t s = 0; s < m; ++s)
+        {
+            strips[s].left = s == 0 ? -std::numeric_limits<double>::infinity() : double(strips[s - 1].maxX);
+            strips[s].right = s + 1 == m ? std::numeric_limits<double>::infinity() : double(strips[s + 1].minX);
+        }
+
+        //各条带并行剖分；不同条带的点编号互不相同，接缝标记可以直接写，不需要加锁
+        std::vector<Delaunay> stripTri(m);
+        std::vector<std::uint8_t> seam(n, 0);
+        std::atomic<bool> degenerate(false);
+        {
+            TaskGroup group(pool);
+            for (std::size_t s = 0; s < m; ++s)
+            {
+                group.run([&, s] { triangulateStrip(strips[s], stripTri[s], seam, degenerate); });
+            }
+            group.wait();
+        }
+        for (const auto& d : stripTri) _instr.merge(d._instr);
+        if (degenerate) return false;
+
+        //接缝点重新剖分
+        std::vector<std::uint32_t> seamIndex;
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            if (seam[i]) seamIndex.push_back(i);
+        }
+        const std::uint32_t ns = static_cast<std::uint32_t>(seamIndex.size());
+        if (ns == 0) return false;
+
+        Delaunay seamTri;
+        seamTri._vertices.resize(ns);
+        for (std::uint32_t j = 0; j < ns; ++j) seamTri._vertices[j] = _points[seamIndex[j]];
+        seamTri.adoptVertices();
+        seamTri._spatialSort = _spatialSort;
+        {
+            T sMinX, sMinY, sMaxX, sMaxY;
+            computeBounds(seamTri._points, sMinX, sMinY, sMaxX, sMaxY);
+            seamTri.insertVertices(sMinX, sMinY, sMaxX - sMinX, sMaxY - sMinY);
+        }
+        _instr.merge(seamTri._instr);
+        auto seamGlobal = [&](std::uint32_t v) { return v < ns ? seamIndex[v] : v; };
+
+        //与某个条带中保留的三角形相同的跳过（判断方法与条带中完全一致），其余的逐个校验
+        std::vector<std::uint32_t> candidates;
+        for (std::uint32_t fi = 0; fi < seamTri._faces.size(); ++fi)
+        {
+            const Face& f = seamTri._faces[fi];
+            if (f.isBad) continue;
+            const std::uint32_t a = seamGlobal(f.v[0]);
+            const std::uint32_t b = seamGlobal(f.v[1]);
+            const std::uint32_t c = seamGlobal(f.v[2]);
+            if (a < n && b < n && c < n)
+            {
+                const std::uint32_t s = stripOf(a);
+                if (stripOf(b) == s && stripOf(c) == s && circleInsideSlab(a, b, c, strips[s].left, strips[s].right))
+                    continue;
+            }
+            candidates.push_back(fi);
+        }
+
+        PointGrid grid;
+        buildPointGrid(grid, minX, minY, maxX, maxY);
+        std::vector<std::uint8_t> accept(candidates.size(), 0);
+        {
+            const std::size_t chunk = 1024;
+            TaskGroup group(pool);
+            for (std::size_t first = 0; first < candidates.size(); first += chunk)
+            {
+                group.run([&, first] {
+                    const std::size_t last = std::min(first + chunk, candidates.size());
+                    for (std::size_t c = first; c < last; ++c)
+                    {
+                        const Face& f = seamTri._faces[candidates[c]];
+                        const std::uint32_t a = seamGlobal(f.v[0]);
+                        const std::uint32_t b = seamGlobal(f.v[1]);
+                        const std::uint32_t d = seamGlobal(f.v[2]);
+                        accept[c] = a >= n || b >= n || d >= n || emptyCircle(grid, a, b, d, degenerate);
+                    }
+                });
+            }
+            group.wait();
+        }
+        if (degenerate) return false;
+
+        //n 个不重合的点都在超级三角形内部，加上它的 3 个顶点共有 2n + 1 个三角形
+        std::vector<std::uint32_t> base(m);
+        std::size_t total = 0;
+        std::size_t used = 0;
+        for (std::size_t s = 0; s < m; ++s)
+        {
+            base[s] = static_cast<std::uint32_t>(total);
+            total += strips[s].safe.size();
+            used += strips[s].used;
+        }
+        const std::uint32_t seamBase = static_cast<std::uint32_t>(total);
+        for (const auto a : accept) total += a;
+        if (total != 2 * used + 1) return false;
+
+        //条带中保留的三角形并行复制到各自的位置，外侧不是保留三角形的边先记下来
+        _faces.resize(total);
+        _circles.resize(total);
+        std::vector<std::vector<std::pair<std::uint64_t, std::uint64_t>>> open(m);
+        {
+            TaskGroup group(pool);
+            for (std::size_t s = 0; s < m; ++s)
+            {
+                group.run([&, s] { copyStripFaces(strips[s], stripTri[s], base[s], open[s]); });
+            }
+            group.wait();
+        }
+        std::vector<Delaunay>().swap(stripTri);
+
+        std::unordered_map<std::uint64_t, std::uint64_t> openEdges;
+        {
+            std::size_t count = 0;
+            for (const auto& o : open) count += o.size();
+            openEdges.reserve(count);
+            for (const auto& o : open) openEdges.insert(o.begin(), o.end());
+        }
+
+        //接缝三角形接在后面，外侧不是接缝三角形的边按反向边找到条带中的三角形
+        std::vector<std::uint32_t> seamRank(seamTri._faces.size(), INVALID_INDEX);
+        std::uint32_t next = seamBase;
+        for (std::size_t c = 0; c < candidates.size(); ++c)
+        {
+            if (accept[c]) seamRank[candidates[c]] = next++;
+        }
+        std::size_t linked = 0;
+        for (std::size_t c = 0; c < candidates.size(); ++c)
+        {
+            if (!accept[c]) continue;
+            const Face& f = seamTri._faces[candidates[c]];
+            const std::uint32_t fi = seamRank[candidates[c]];
+            Face& g = _faces[fi];
+            g = makeFace(seamGlobal(f.v[0]), seamGlobal(f.v[1]), seamGlobal(f.v[2]));
+            _circles.copyFrom(seamTri._circles, candidates[c], fi);
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.n[e] == INVALID_INDEX || seamRank[f.n[e]] != INVALID_INDEX)
                 {
-                    //std::cout << " does not contains " << *p << " in his circum center" << std::endl;
+                    g.n[e] = f.n[e] == INVALID_INDEX ? INVALID_INDEX : seamRank[f.n[e]];
+                    continue;
                 }
+                const auto it = openEdges.find(edgeKey(g.v[(e + 1) % 3], g.v[e]));
+                if (it == openEdges.end()) return false;
+                const std::uint32_t other = static_cast<std::uint32_t>(it->second >> 2);
+                g.n[e] = other;
+                _faces[other].n[it->second & 3] = fi;
+                ++linked;
+            }
+        }
+        if (linked != openEdges.size()) return false;
+
+        //恢复插入用的辅助结构，之后仍可以继续插入点
+        _fanStart.assign(n + 3, INVALID_INDEX);
+        _vertexFace.assign(n, INVALID_INDEX);
+        _freeFaces.clear();
+        _lastFace = 0;
+        initGrid(minX, minY, maxX - minX, maxY - minY);
+        for (std::uint32_t fi = 0; fi < _faces.size(); ++fi)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                const std::uint32_t v = _faces[fi].v[e];
+                if (v >= n) continue;
+                _vertexFace[v] = fi;
+                const VertexType p = _points[v];
+                _grid[cellY(p) * _gridW + cellX(p)] = v;
             }
-            // _triangles
-            _triangles.erase(std::remove_if(begin(_triangles), end(_triangles), [](TriangleType& t) {
-                return t.isBad;
-                }), end(_triangles));   //std::remove_ifֻƶɾeraseɾﻹõC++11 lambda ʽ
+        }
+        return true;
+    }
+
+    //剖分一个条带：标记接缝点，记下外接圆严格落在条带内的三角形，并检查相邻三角形是否四点共圆。
+    //条带的点按条带内编号拷贝一份，各线程只访问自己的连续数组
+    void triangulateStrip(Strip& strip, Delaunay& d, std::vector<std::uint8_t>& seam, std::atomic<bool>& degenerate) const
+    {
+        const std::uint32_t sn = static_cast<std::uint32_t>(strip.index.size());
+        d._vertices.resize(sn);
+        for (std::uint32_t j = 0; j < sn; ++j) d._vertices[j] = _points[strip.index[j]];
+        d.adoptVertices();
+        d._spatialSort = _spatialSort;
+        d.insertVertices(strip.minX, strip.minY, strip.maxX - strip.minX, strip.maxY - strip.minY);
+
+        auto global = [&](std::uint32_t v) { return v < sn ? strip.index[v] : v; };
+        std::vector<std::uint8_t> used(sn, 0);
+        for (std::uint32_t fi = 0; fi < d._faces.size(); ++fi)
+        {
+            const Face& f = d._faces[fi];
+            if (f.isBad) continue;
+            const bool real = f.v[0] < sn && f.v[1] < sn && f.v[2] < sn;
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.v[e] < sn) used[f.v[e]] = 1;
+            }
+
+            //相邻两个三角形的四个顶点共圆时剖分不唯一，条带中的选择可能与串行插入不同
+            for (int e = 0; e < 3 && real; ++e)
+            {
+                const std::uint32_t g = f.n[e];
+                if (g == INVALID_INDEX || g < fi) continue;
+                const Face& o = d._faces[g];
+                const std::uint32_t opposite = o.v[0] + o.v[1] + o.v[2] - f.v[e] - f.v[(e + 1) % 3];
+                if (opposite >= sn) continue;
+                const VertexType p = d._points[opposite];
+                if (d._circles.classify(fi, p.x, p.y) == 0 && d.inCircle(f, p) == 0) degenerate = true;
+            }
+
+            if (real && circleInsideSlab(global(f.v[0]), global(f.v[1]), global(f.v[2]), strip.left, strip.right))
+            {
+                strip.safe.push_back(fi);
+                continue;
+            }
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.v[e] < sn) seam[strip.index[f.v[e]]] = 1;
+            }
+        }
+        strip.used = static_cast<std::size_t>(std::count(used.begin(), used.end(), std::uint8_t(1)));
+    }
+
+    //把条带中保留的三角形换成全局编号，写到 _faces[base] 开始的位置
+    void copyStripFaces(const Strip& strip, const Delaunay& d, std::uint32_t base,
+        std::vector<std::pair<std::uint64_t, std::uint64_t>>& open)
+    {
+        std::vector<std::uint32_t> rank(d._faces.size(), INVALID_INDEX);
+        for (std::uint32_t r = 0; r < strip.safe.size(); ++r) rank[strip.safe[r]] = base + r;
+
+        for (std::uint32_t r = 0; r < strip.safe.size(); ++r)
+        {
+            const Face& f = d._faces[strip.safe[r]];
+            const std::uint32_t fi = base + r;
+            Face& g = _faces[fi];
+            g = makeFace(strip.index[f.v[0]], strip.index[f.v[1]], strip.index[f.v[2]]);
+            for (int e = 0; e < 3; ++e)
+            {
+                g.n[e] = f.n[e] == INVALID_INDEX ? INVALID_INDEX : rank[f.n[e]];
+                if (g.n[e] == INVALID_INDEX)
+                    open.emplace_back(edgeKey(g.v[e], g.v[(e + 1) % 3]), (std::uint64_t(fi) << 2) | std::uint64_t(e));
+            }
+            _circles.copyFrom(d._circles, strip.safe[r], fi);
+        }
+    }
+
+    static std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b)
+    {
+        return (std::uint64_t(a) << 32) | b;
+    }
+
+    //三角形 (a, b, c) 的外接圆是否严格落在 left < x < right 之内。圆心、半径的误差都计入余量，只会误判为否。
+    //先把编号最小的顶点轮换到最前面再计算，同一个三角形无论来自哪次剖分，结论都相同
+    bool circleInsideSlab(std::uint32_t a, std::uint32_t b, std::uint32_t c, double left, double right) const
+    {
+        while (a > b || a > c)
+        {
+            const std::uint32_t t = a;
+            a = b;
+            b = c;
+            c = t;
+        }
+        const VertexType pa = point(a);
+        const VertexType pb = point(b);
+        const VertexType pc = point(c);
+        double x, y, r2, err;
+        computeCircumCircle(pa.x, pa.y, pb.x, pb.y, pc.x, pc.y, x, y, r2, err);
+        if (!(r2 < std::numeric_limits<double>::infinity())) return false;
+
+        const double r = std::sqrt(r2);
+        const double margin = 2 * err + 8 * std::numeric_limits<double>::epsilon() * (r + std::abs(x));
+        return x - r - margin > left && x + r + margin < right;
+    }
+
+    static std::size_t clampCell(double v, std::size_t size)
+    {
+        return v <= 0 ? 0 : v >= double(size - 1) ? size - 1 : static_cast<std::size_t>(v);
+    }
+
+    //按每格约两个点建立校验用的点网格
+    void buildPointGrid(PointGrid& grid, T minX, T minY, T maxX, T maxY) const
+    {
+        const std::size_t n = _points.size();
+        const double w = std::max<double>(maxX - minX, std::numeric_limits<double>::min());
+        const double h = std::max<double>(maxY - minY, std::numeric_limits<double>::min());
+        const double cells = std::max<double>(1.0, n / 2.0);
+        grid.cell = std::max(std::sqrt(w * h / cells), std::max(w, h) / cells);
+        grid.invCell = 1.0 / grid.cell;
+        grid.minX = minX;
+        grid.minY = minY;
+        grid.w = std::min<std::size_t>(static_cast<std::size_t>(w / grid.cell) + 1, 1u << 15);
+        grid.h = std::min<std::size_t>(static_cast<std::size_t>(h / grid.cell) + 1, 1u << 15);
+
+        //点落格时坐标相减、相乘的舍入会让点略微越过格子边界，查询时格子按这个余量向外扩
+        grid.pad = 1e-9 * grid.cell + 8 * std::numeric_limits<double>::epsilon()
+            * (std::abs(double(minX)) + std::abs(double(maxX)) + std::abs(double(minY)) + std::abs(double(maxY)));
+
+        auto cellOf = [&](const VertexType& p) {
+            return clampCell((p.y - grid.minY) * grid.invCell, grid.h) * grid.w + clampCell((p.x - grid.minX) * grid.invCell, grid.w);
+        };
+        grid.start.assign(grid.w * grid.h + 1, 0);
+        for (std::size_t i = 0; i < n; ++i) ++grid.start[cellOf(_points[i]) + 1];
+        for (std::size_t c = 0; c + 1 < grid.start.size(); ++c) grid.start[c + 1] += grid.start[c];
 
-            for (auto e1 = begin(polygon); e1 != end(polygon); ++e1)  //ɾظı
+        std::vector<std::uint32_t> fill(grid.start.begin(), grid.start.end() - 1);
+        grid.points.resize(n);
+        for (std::uint32_t i = 0; i < n; ++i) grid.points[fill[cellOf(_points[i])]++] = i;
+    }
+
+    //三角形 (a, b, c)（逆时针）的外接圆内是否没有任何输入点。先用带误差界的外接圆筛选，
+    //无法确定时调用精确的 incircle；有不重合的点恰好落在圆上时置 degenerate
+    bool emptyCircle(const PointGrid& grid, std::uint32_t a, std::uint32_t b, std::uint32_t c, std::atomic<bool>& degenerate) const
+    {
+        const VertexType pa = point(a);
+        const VertexType pb = point(b);
+        const VertexType pc = point(c);
+        double x, y, r2, err, tolA, tolB;
+        computeCircumCircle(pa.x, pa.y, pb.x, pb.y, pc.x, pc.y, x, y, r2, err);
+        if (!(r2 < std::numeric_limits<double>::infinity()))
+        {
+            degenerate = true;
+            return false;
+        }
+        computeCircumTolerance(r2, err, std::numeric_limits<double>::epsilon(), tolA, tolB);
+
+        //逐行求出与圆相交的格子，首尾两行、两列包含被截到网格范围内的点，向外不设边界
+        const double inf = std::numeric_limits<double>::infinity();
+        const double reach = std::sqrt(r2) + 2 * err + grid.pad;
+        const std::size_t rowFirst = clampCell((y - reach - grid.minY) * grid.invCell, grid.h);
+        const std::size_t rowLast = clampCell((y + reach - grid.minY) * grid.invCell, grid.h);
+        for (std::size_t row = rowFirst; row <= rowLast; ++row)
+        {
+            const double y0 = row == 0 ? -inf : grid.minY + row * grid.cell - grid.pad;
+            const double y1 = row + 1 == grid.h ? inf : grid.minY + (row + 1) * grid.cell + grid.pad;
+            const double dy = std::max(0.0, std::max(y0 - y, y - y1));
+            if (dy > reach) continue;
+            const double halfWidth = std::sqrt(reach * reach - dy * dy);
+            const std::size_t colFirst = clampCell((x - halfWidth - grid.minX) * grid.invCell, grid.w);
+            const std::size_t colLast = clampCell((x + halfWidth - grid.minX) * grid.invCell, grid.w);
+
+            for (std::size_t col = colFirst; col <= colLast; ++col)
             {
-                for (auto e2 = e1 + 1; e2 != end(polygon); ++e2)
+                const std::size_t cell = row * grid.w + col;
+                for (std::uint32_t k = grid.start[cell]; k < grid.start[cell + 1]; ++k)
                 {
-                    if (almost_equal(*e1, *e2))
+                    const VertexType p = _points[grid.points[k]];
+                    if (p == pa || p == pb || p == pc) continue;
+                    const int side = classifyCircumCircle<double>(x, y, r2, tolA, tolB, p.x, p.y);
+                    if (side < 0) continue;
+                    if (side > 0) return false;
+
+                    const double det = predicates::incircle(pa.x, pa.y, pb.x, pb.y, pc.x, pc.y, p.x, p.y);
+                    if (det > 0) return false;
+                    if (det == 0)
                     {
-                        e1->isBad = true;
-                        e2->isBad = true;
+                        degenerate = true;
+                        return false;
                     }
                 }
             }
+        }
+        return true;
+    }
 
-            // polygon
-            polygon.erase(std::remove_if(begin(polygon), end(polygon), [](EdgeType& e) {
-                return e.isBad;
-                }), end(polygon));
+    //按编号取输入点，超级三角形顶点没有坐标，不能用这个函数
+    VertexType point(std::uint32_t i) const
+    {
+        return _points[i];
+    }
 
-            for (const auto e : polygon)
-                _triangles.push_back(TriangleType(e.p1, e.p2, *p));
+    //顶点在 _fanStart 中的位置，超级三角形顶点排在输入点之后
+    std::size_t fanSlot(std::uint32_t v) const
+    {
+        return v < SUPER_INDEX ? v : _points.size() + (v - SUPER_INDEX);
+    }
 
+    //外接圆行列式的符号，1 表示 p 在逆时针三角形 f 的外接圆内，0 表示在圆上（符号是精确的）。
+    //含超级顶点的三角形按符号化的规则计算
+    int inCircle(const Face& f, const VertexType& p) const
+    {
+        return SuperTriangle::inCircle(_points, f.v[0], f.v[1], f.v[2], p);
+    }
+
+    //判断 p 是否在第 fi 个三角形的外接圆内（包括圆上）。
+    //先用缓存的外接圆比较距离，只有 p 离圆周近到超出缓存误差界时才计算精确行列式
+    bool circumCircleContains(std::uint32_t fi, const VertexType& p) const
+    {
+        const int side = _circles.classify(fi, p.x, p.y);
+        _instr.circleTest(side == 0);
+        if (side != 0) return side > 0;
+        return inCircle(_faces[fi], p) >= 0;
+    }
+
+    //添加一个新三角形并缓存其外接圆，优先复用空闲链表中失效三角形的位置
+    std::uint32_t addFace(const Face& f)
+    {
+        std::uint32_t fi;
+        if (!_freeFaces.empty())
+        {
+            fi = _freeFaces.back();
+            _freeFaces.pop_back();
+            _faces[fi] = f;
+            _instr.faceSlot(true);
+        }
+        else
+        {
+            fi = static_cast<std::uint32_t>(_faces.size());
+            _faces.push_back(f);
+            _circles.resize(_faces.size());
+            _instr.faceSlot(false);
         }
 
-        //ɾ
-        _triangles.erase(std::remove_if(begin(_triangles), end(_triangles), [p1, p2, p3](TriangleType& t) {
-            return t.containsVertex(p1) || t.containsVertex(p2) || t.containsVertex(p3);
-            }), end(_triangles));
+        for (int e = 0; e < 3; ++e)
+        {
+            if (f.v[e] < SUPER_INDEX) _vertexFace[f.v[e]] = fi;
+        }
+        if (isInputFace(f))
+        {
+            const VertexType a = point(f.v[0]);
+            const VertexType b = point(f.v[1]);
+            const VertexType c = point(f.v[2]);
+            _circles.set(fi, a.x, a.y, b.x, b.y, c.x, c.y);
+        }
+        else
+        {
+            _circles.setUnbounded(fi);
+        }
+        return fi;
+    }
+
+    //按点数建立均匀网格，每个格子记录最近在其中插入的点，从这个点所在的三角形开始行走
+    void initGrid(T minX, T minY, T dx, T dy)
+    {
+        const double cells = std::max<double>(1.0, _points.size() / 8.0);
+        const double w = std::max<double>(dx, std::numeric_limits<double>::min());
+        const double h = std::max<double>(dy, std::numeric_limits<double>::min());
+        const double cellSize = std::max(std::sqrt(w * h / cells), std::max(w, h) / cells);
+
+        _gridMinX = minX;
+        _gridMinY = minY;
+        _gridInvCell = 1.0 / cellSize;
+        _gridW = std::min<std::size_t>(static_cast<std::size_t>(w / cellSize) + 1, 1u << 15);
+        _gridH = std::min<std::size_t>(static_cast<std::size_t>(h / cellSize) + 1, 1u << 15);
+        _grid.assign(_gridW * _gridH, INVALID_INDEX);
+        _gridVertexCount = _points.size();
+    }
+
+    std::size_t cellX(const VertexType& p) const
+    {
+        const double x = (p.x - _gridMinX) * _gridInvCell;
+        return x <= 0 ? 0 : std::min(static_cast<std::size_t>(x), _gridW - 1);
+    }
 
-        for (const auto t : _triangles)
+    std::size_t cellY(const VertexType& p) const
+    {
+        const double y = (p.y - _gridMinY) * _gridInvCell;
+        return y <= 0 ? 0 : std::min(static_cast<std::size_t>(y), _gridH - 1);
+    }
+
+    //在 p 所在格子及其周围两圈格子中寻找一个仍在剖分中的点，从它所在的三角形出发，找不到时从上一次插入的位置出发。
+    //网格记录点而不是三角形：三角形的位置会被复用，记下的三角形可能早已换成别处的三角形
+    std::uint32_t startFace(const VertexType& p) const
+    {
+        const long cx = static_cast<long>(cellX(p));
+        const long cy = static_cast<long>(cellY(p));
+        for (long r = 0; r <= 2; ++r)
         {
-            _edges.push_back(t.e1);
-            _edges.push_back(t.e2);
-            _edges.push_back(t.e3);
+            for (long y = cy - r; y <= cy + r; ++y)
+            {
+                if (y < 0 || y >= static_cast<long>(_gridH)) continue;
+                for (long x = cx - r; x <= cx + r; ++x)
+                {
+                    if (x < 0 || x >= static_cast<long>(_gridW)) continue;
+                    if (std::labs(x - cx) != r && std::labs(y - cy) != r) continue;
+
+                    const std::uint32_t v = _grid[y * _gridW + x];
+                    if (v != INVALID_INDEX && isVertex(v)) return _vertexFace[v];
+                }
+            }
         }
+        return _lastFace;
+    }
 
-        return _triangles;
+    //第 v 个点是否仍是剖分的顶点（没有被删除）
+    bool isVertex(std::uint32_t v) const
+    {
+        const std::uint32_t f = _vertexFace[v];
+        return f != INVALID_INDEX && !_faces[f].isBad && (_faces[f].v[0] == v || _faces[f].v[1] == v || _faces[f].v[2] == v);
     }
 
-    const std::vector<TriangleType>& getTriangles() const { return _triangles; }
-    const std::vector<EdgeType>& getEdges() const { return _edges; }
-    const std::vector<VertexType>& getVertices() const { return _vertices; }
+    //从起点沿邻接关系向 p 行走（随机选择起始边，避免退化时原地打转），返回包含 p 的三角形
+    std::uint32_t locate(const VertexType& p)
+    {
+        std::uint32_t f = startFace(p);
+        for (std::size_t step = 0; step < _faces.size(); ++step)
+        {
+            _instr.walkStep();
+            const Face& face = _faces[f];
+            _seed = _seed * 1103515245u + 12345u;
+            const int r = static_cast<int>((_seed >> 16) % 3);
+
+            std::uint32_t next = INVALID_INDEX;
+            for (int k = 0; k < 3 && next == INVALID_INDEX; ++k)
+            {
+                const int e = (r + k) % 3;
+                if (face.n[e] != INVALID_INDEX && SuperTriangle::orient(_points, face.v[e], face.v[(e + 1) % 3], p) < 0)
+                    next = face.n[e];
+            }
+            if (next == INVALID_INDEX) return f;
+            f = next;
+        }
+
+        //谓词是精确的，Delaunay 三角剖分上的行走总能结束；这里只作为保险，退回到线性扫描，按块批量检测外接圆
+        std::uint8_t inside[256];
+        for (std::size_t first = 0; first < _faces.size(); first += 256)
+        {
+            const std::size_t count = std::min<std::size_t>(256, _faces.size() - first);
+            _circles.containsBatch(p.x, p.y, first, count, inside);
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                const std::uint32_t i = static_cast<std::uint32_t>(first + k);
+                if (inside[k] && !_faces[i].isBad && circumCircleContains(i, p)) return i;
+            }
+        }
+        return f;
+    }
+
+    //插入第 vi 个点：定位、扩散出空腔、用空腔边界与新点连成新的三角形。
+    //返回 vi；与已有顶点重合时不插入，返回那个顶点的编号
+    std::uint32_t insertVertex(std::uint32_t vi)
+    {
+        const VertexType p = _points[vi];
+        const std::uint32_t start = locate(p);
+
+        //与已有顶点重合的点不再插入
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::uint32_t v = _faces[start].v[k];
+            if (v < SUPER_INDEX && _points[v] == p) return v;
+        }
+
+        //以包含 p 的三角形为种子，沿邻接关系找出所有外接圆包含 p 的三角形
+        _cavity.clear();
+        _faces[start].isBad = true;
+        _cavity.push_back(start);
+        for (std::size_t k = 0; k < _cavity.size(); ++k)
+        {
+            const Face& f = _faces[_cavity[k]];
+            for (int e = 0; e < 3; ++e)
+            {
+                const std::uint32_t ni = f.n[e];
+                if (ni != INVALID_INDEX && !_faces[ni].isBad && circumCircleContains(ni, p))
+                {
+                    _faces[ni].isBad = true;
+                    _cavity.push_back(ni);
+                }
+            }
+        }
+
+        //外侧不是坏三角形的边就是空腔边界
+        _polygon.clear();
+        for (const std::uint32_t fi : _cavity)
+        {
+            const Face& f = _faces[fi];
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.n[e] == INVALID_INDEX || !_faces[f.n[e]].isBad)
+                    _polygon.push_back(BoundaryEdge{ f.v[e], f.v[(e + 1) % 3], f.n[e] });
+            }
+        }
+        releaseCavity();
+        _instr.cavity(_cavity.size(), _polygon.size());
+
+        //每条边界边与 p 构成新三角形，并接回外侧三角形；新三角形先占用刚释放的空腔位置
+        _newFaces.clear();
+        for (const auto& be : _polygon)
+        {
+            Face f = makeFace(be.a, be.b, vi);
+            f.n[0] = be.outer;
+            const std::uint32_t fi = addFace(f);
+            _newFaces.push_back(fi);
+            if (be.outer != INVALID_INDEX)
+            {
+                Face& o = _faces[be.outer];
+                for (int e = 0; e < 3; ++e)
+                {
+                    if (o.v[e] == be.b && o.v[(e + 1) % 3] == be.a) o.n[e] = fi;
+                }
+            }
+        }
+
+        //空腔边界是一个闭合多边形，每个边界顶点恰好是一条边界边的起点，
+        //以起点编号为键登记新三角形，即可在线性时间内连接相邻的新三角形
+        for (const std::uint32_t i : _newFaces)
+        {
+            _fanStart[fanSlot(_faces[i].v[0])] = i;
+        }
+        for (const std::uint32_t i : _newFaces)
+        {
+            const std::uint32_t j = _fanStart[fanSlot(_faces[i].v[1])];
+            _faces[i].n[1] = j;
+            _faces[j].n[2] = i;
+        }
+
+        const std::uint32_t first = _newFaces[0];
+        _lastFace = first;
+        _grid[cellY(p) * _gridW + cellX(p)] = vi;
+        _instr.faceCount(_faces.size() - _freeFaces.size(), _faces.size());
+        return vi;
+    }
+
+    //空腔中的三角形已经失效（isBad），把它们的位置放进空闲链表，之后新建的三角形优先复用。
+    //插入时新三角形比空腔多两个，空闲链表每次都会用完，数组只在剖分变大时增长
+    void releaseCavity()
+    {
+        _freeFaces.insert(_freeFaces.end(), _cavity.begin(), _cavity.end());
+    }
 
-private:
     std::vector<TriangleType> _triangles;
     std::vector<EdgeType> _edges;
+    bool _edgesValid = false;
+    std::vector<std::uint32_t> _hull;
+    std::vector<std::uint32_t> _hullNext;
+    //剖分读取坐标的视图：指向调用方的数组，或指向内部的 _vertices（动态更新、条带剖分时）
+    PointView<T> _points;
     std::vector<VertexType> _vertices;
+    bool _ownPoints = true;
+    MeshType _mesh;
+    PhaseTimes _phases;
+
+    //外接圆检测等 const 函数中也要计数，计数不影响剖分结果
+    mutable Instrumentation _instr;
+
+    //插入过程中使用的索引结构
+    std::vector<Face> _faces;
+    CircumCircleBlock _circles;
+    std::vector<std::uint32_t> _cavity;
+    std::vector<BoundaryEdge> _polygon;
+    std::vector<std::uint32_t> _fanStart;
+    std::vector<std::uint32_t> _vertexFace;     //每个点所在的一个三角形，新建三角形时更新
+    std::vector<std::uint32_t> _freeFaces;
+    std::vector<std::uint32_t> _newFaces;
+    std::vector<std::uint32_t> _ring;
+    std::vector<std::uint32_t> _remap;
+    std::vector<std::pair<std::uint32_t, int>> _across;
+    std::uint32_t _lastFace = 0;
+    std::uint32_t _seed = 1;
+    bool _parallel = false;
+    bool _spatialSort = false;
+    std::vector<std::uint32_t> _order;
+    DelaunayEngine _engine = DelaunayEngine::BowyerWatson;
+    SweepHull<T> _sweep;
+    DivideConquer<T> _divide;
+    //_faces 中是否有超级三角形、插入用的辅助结构是否有效；由其他算法剖分后为 false，直到 attachSuperTriangle
+    bool _superFaces = true;
+
+    //点定位网格，每格记下最近插入的一个点
+    std::vector<std::uint32_t> _grid;
+    std::size_t _gridW = 0;
+    std::size_t _gridH = 0;
+    double _gridMinX = 0;
+    double _gridMinY = 0;
+    double _gridInvCell = 1;
+    std::size_t _gridVertexCount = 0;
 };
 #endif
@@ -0,0 +1,358 @@
+#pragma once
+#ifndef H_DIVIDE_CONQUER
+#define H_DIVIDE_CONQUER
+
+#include "vector2.h"
+#include "point_view.h"
+#include "predicates.h"
+#include "thread_pool.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+//Guibas–Stolfi 分治剖分：点按 (x, y) 排序后对半切分，两半分别剖分，再从下公切线开始
+//自下而上逐条加入连接两半的边，同时删掉不再满足空圆性质的边。每层合并是线性的，总复杂度确定为 O(n log n)，
+//与插入顺序、点的分布无关；圆上的点、密集网格等让逐点插入退化的输入也是如此。
+//剖分保存在四边（quad-edge）结构中：每条无向边有 4 个有向边（原边、对偶边及其反向），e 的编号为 4q + r。
+//两半的剖分互不相交，递归的上几层把左半交给线程池，与右半同时进行。
+//orient / incircle 都使用精确谓词；结果转换为与 SweepHull 相同的三角形、半边数组
+template <class T>
+class DivideConquer
+{
+public:
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    //每 3 个编号组成一个逆时针三角形，半边 e 从 triangles[e] 指向同一三角形中的下一个顶点
+    std::vector<std::uint32_t> triangles;
+
+    //halfedges[e] 为半边 e 的反向半边，凸包边为 INVALID_INDEX
+    std::vector<std::uint32_t> halfedges;
+
+    //剖分 points，完全重合的点只保留编号最小的一个。pool 不为空时递归的上几层并行。
+    //少于三个不重合的点或全部共线（没有三角形）时返回 false
+    bool triangulate(const PointView<T>& points, ThreadPool* pool = nullptr)
+    {
+        triangles.clear();
+        halfedges.clear();
+        _parallel = false;
+        const std::size_t n = points.size();
+        if (n < 3 || n >= INVALID_INDEX / 12) return false;
+
+        //按 (x, y) 排序并去掉重合的点，坐标按排序后的顺序存放，递归中相邻的点在内存中也相邻
+        _sorted.resize(n);
+        for (std::uint32_t i = 0; i < n; ++i) _sorted[i] = i;
+        std::sort(_sorted.begin(), _sorted.end(), [&](std::uint32_t a, std::uint32_t b) {
+            if (points.x(a) != points.x(b)) return points.x(a) < points.x(b);
+            if (points.y(a) != points.y(b)) return points.y(a) < points.y(b);
+            return a < b;
+        });
+        std::size_t m = 0;
+        _x.resize(n);
+        _y.resize(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const double x = points.x(_sorted[k]), y = points.y(_sorted[k]);
+            if (m > 0 && x == _x[m - 1] && y == _y[m - 1]) continue;
+            _sorted[m] = _sorted[k];
+            _x[m] = x;
+            _y[m] = y;
+            ++m;
+        }
+        if (m < 3) return false;
+
+        //m 个点的平面图不超过 3m - 6 条边，合并过程中的图始终是平面图，每个子问题按 3 倍点数分配四边结构
+        _onext.resize(4 * 3 * m);
+        _org.resize(2 * 3 * m);
+        const std::uint32_t count = static_cast<std::uint32_t>(m);
+        const std::uint32_t grain = pool && pool->size() > 1 ? std::max<std::uint32_t>(PARALLEL_MIN_POINTS, count / (4 * pool->size())) : count;
+        _parallel = count > grain;
+        build(0, count, 0, pool, grain);
+        extractTriangles(count);
+        return !triangles.empty();
+    }
+
+    //上一次剖分是否有子问题交给了线程池
+    bool lastRunParallel() const { return _parallel; }
+
+    //清空结果，保留缓冲区的容量
+    void clear()
+    {
+        triangles.clear();
+        halfedges.clear();
+    }
+
+    //按不超过 n 个点预先分配
+    void reserve(std::size_t n)
+    {
+        triangles.reserve(6 * n);
+        halfedges.reserve(6 * n);
+        _sorted.reserve(n);
+        _x.reserve(n);
+        _y.reserve(n);
+        _onext.reserve(12 * n);
+        _org.reserve(6 * n);
+        _face.reserve(6 * n);
+    }
+
+private:
+    //子问题点数不超过此值时不再拆分任务
+    static constexpr std::uint32_t PARALLEL_MIN_POINTS = 1u << 15;
+
+    //一个子问题的剖分：le 为从最左点出发、逆时针方向的凸包边，re 为从最右点出发、顺时针方向的凸包边；
+    //free 为本子问题分配区域中空闲的四边结构，经由 _onext[4q] 串成单链表
+    struct Hull
+    {
+        std::uint32_t le;
+        std::uint32_t re;
+        std::uint32_t freeHead;
+        std::uint32_t freeTail;
+    };
+
+    static std::uint32_t rot(std::uint32_t e) { return (e & ~3u) | ((e + 1) & 3u); }
+    static std::uint32_t rotInv(std::uint32_t e) { return (e & ~3u) | ((e + 3) & 3u); }
+    static std::uint32_t sym(std::uint32_t e) { return e ^ 2u; }
+
+    std::uint32_t onext(std::uint32_t e) const { return _onext[e]; }
+    std::uint32_t oprev(std::uint32_t e) const { return rot(_onext[rot(e)]); }
+    std::uint32_t lnext(std::uint32_t e) const { return rot(_onext[rotInv(e)]); }
+    std::uint32_t rprev(std::uint32_t e) const { return _onext[sym(e)]; }
+
+    //原边 e 的起点、终点（排序后的点编号）
+    std::uint32_t org(std::uint32_t e) const { return _org[e >> 1]; }
+    std::uint32_t dest(std::uint32_t e) const { return _org[sym(e) >> 1]; }
+
+    double orient(std::uint32_t a, std::uint32_t b, std::uint32_t c) const
+    {
+        return predicates::orient2d(_x[a], _y[a], _x[b], _y[b], _x[c], _y[c]);
+    }
+
+    double inCircle(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) const
+    {
+        return predicates::incircle(_x[a], _y[a], _x[b], _y[b], _x[c], _y[c], _x[d], _y[d]);
+    }
+
+    bool rightOf(std::uint32_t p, std::uint32_t e) const { return orient(p, dest(e), org(e)) > 0; }
+    bool leftOf(std::uint32_t p, std::uint32_t e) const { return orient(p, org(e), dest(e)) > 0; }
+
+    //新建一条从 a 到 b 的孤立边，四边结构取自 h 的空闲链表
+    std::uint32_t makeEdge(Hull& h, std::uint32_t a, std::uint32_t b)
+    {
+        const std::uint32_t q = h.freeHead;
+        h.freeHead = _onext[4 * q];
+        const std::uint32_t e = 4 * q;
+        _onext[e] = e;
+        _onext[e + 1] = e + 3;
+        _onext[e + 2] = e + 2;
+        _onext[e + 3] = e + 1;
+        _org[2 * q] = a;
+        _org[2 * q + 1] = b;
+        return e;
+    }
+
+    //交换 a、b 的起点环（及其对偶环）：不相连时合并，相连时拆开
+    void splice(std::uint32_t a, std::uint32_t b)
+    {
+        const std::uint32_t alpha = rot(_onext[a]);
+        const std::uint32_t beta = rot(_onext[b]);
+        std::swap(_onext[a], _onext[b]);
+        std::swap(_onext[alpha], _onext[beta]);
+    }
+
+    //连接 a 的终点与 b 的起点，新边的左侧与 a、b 的左侧是同一个面
+    std::uint32_t connect(Hull& h, std::uint32_t a, std::uint32_t b)
+    {
+        const std::uint32_t e = makeEdge(h, dest(a), org(b));
+        splice(e, lnext(a));
+        splice(sym(e), b);
+        return e;
+    }
+
+    //删除边 e，四边结构放回空闲链表
+    void deleteEdge(Hull& h, std::uint32_t e)
+    {
+        splice(e, oprev(e));
+        splice(sym(e), oprev(sym(e)));
+        const std::uint32_t q = e >> 2;
+        _org[2 * q] = _org[2 * q + 1] = INVALID_INDEX;
+        _onext[4 * q] = h.freeHead;
+        if (h.freeHead == INVALID_INDEX) h.freeTail = q;
+        h.freeHead = q;
+    }
+
+    //剖分排序后编号在 [lo, hi) 的点，使用从 base 开始的 3 * (hi - lo) 个四边结构
+    Hull build(std::uint32_t lo, std::uint32_t hi, std::uint32_t base, ThreadPool* pool, std::uint32_t grain)
+    {
+        const std::uint32_t count = hi - lo;
+        if (count <= 3)
+        {
+            //区域中的四边结构全部放进空闲链表
+            Hull h;
+            h.freeHead = base;
+            h.freeTail = base + 3 * count - 1;
+            for (std::uint32_t q = base; q < base + 3 * count; ++q)
+            {
+                _onext[4 * q] = q + 1 == base + 3 * count ? INVALID_INDEX : q + 1;
+                _org[2 * q] = _org[2 * q + 1] = INVALID_INDEX;
+            }
+
+            const std::uint32_t a = makeEdge(h, lo, lo + 1);
+            if (count == 2)
+            {
+                h.le = a;
+                h.re = sym(a);
+                return h;
+            }
+            const std::uint32_t b = makeEdge(h, lo + 1, lo + 2);
+            splice(sym(a), b);
+            const double o = orient(lo, lo + 1, lo + 2);
+            if (o > 0)
+            {
+                connect(h, b, a);
+                h.le = a;
+                h.re = sym(b);
+            }
+            else if (o < 0)
+            {
+                const std::uint32_t c = connect(h, b, a);
+                h.le = sym(c);
+                h.re = c;
+            }
+            else
+            {
+                h.le = a;
+                h.re = sym(b);
+            }
+            return h;
+        }
+
+        const std::uint32_t mid = lo + count / 2;
+        Hull left, right;
+        if (pool && count > grain)
+        {
+            TaskGroup group(*pool);
+            group.run([&] { left = build(lo, mid, base, pool, grain); });
+            right = build(mid, hi, base + 3 * (mid - lo), pool, grain);
+            group.wait();
+        }
+        else
+        {
+            left = build(lo, mid, base, pool, grain);
+            right = build(mid, hi, base + 3 * (mid - lo), pool, grain);
+        }
+        return merge(left, right);
+    }
+
+    //合并左右两半的剖分
+    Hull merge(const Hull& left, const Hull& right)
+    {
+        //两个子问题的空闲链表接在一起，合并中新建的边从中分配
+        Hull h;
+        if (left.freeHead == INVALID_INDEX)
+        {
+            h.freeHead = right.freeHead;
+            h.freeTail = right.freeTail;
+        }
+        else
+        {
+            h.freeHead = left.freeHead;
+            h.freeTail = right.freeHead == INVALID_INDEX ? left.freeTail : right.freeTail;
+            _onext[4 * left.freeTail] = right.freeHead;
+        }
+
+        std::uint32_t ldo = left.le, ldi = left.re;
+        std::uint32_t rdi = right.le, rdo = right.re;
+
+        //下公切线
+        for (;;)
+        {
+            if (leftOf(org(rdi), ldi)) ldi = lnext(ldi);
+            else if (rightOf(org(ldi), rdi)) rdi = rprev(rdi);
+            else break;
+        }
+
+        std::uint32_t basel = connect(h, sym(rdi), ldi);
+        if (org(ldi) == org(ldo)) ldo = sym(basel);
+        if (org(rdi) == org(rdo)) rdo = basel;
+
+        //自下而上加入连接两半的边；候选边的终点在 basel 右侧才有效
+        for (;;)
+        {
+            std::uint32_t lcand = onext(sym(basel));
+            const bool lvalid = rightOf(dest(lcand), basel);
+            if (lvalid)
+            {
+                while (inCircle(dest(basel), org(basel), dest(lcand), dest(onext(lcand))) > 0)
+                {
+                    const std::uint32_t t = onext(lcand);
+                    deleteEdge(h, lcand);
+                    lcand = t;
+                }
+            }
+
+            std::uint32_t rcand = oprev(basel);
+            const bool rvalid = rightOf(dest(rcand), basel);
+            if (rvalid)
+            {
+                while (inCircle(dest(basel), org(basel), dest(rcand), dest(oprev(rcand))) > 0)
+                {
+                    const std::uint32_t t = oprev(rcand);
+                    deleteEdge(h, rcand);
+                    rcand = t;
+                }
+            }
+
+            if (!lvalid && !rvalid) break;
+            if (!lvalid || (rvalid && inCircle(dest(lcand), org(lcand), org(rcand), dest(rcand)) > 0))
+                basel = connect(h, rcand, sym(basel));
+            else
+                basel = connect(h, sym(basel), sym(lcand));
+        }
+
+        h.le = ldo;
+        h.re = rdo;
+        return h;
+    }
+
+    //沿每条有向边左侧的面走一圈，逆时针的三角形就是剖分的三角形（凸包外的面是顺时针的）；
+    //顶点换回输入编号，半边按有向边查到的位置互相连接
+    void extractTriangles(std::uint32_t count)
+    {
+        const std::uint32_t edges = 2 * 3 * count;
+        _face.assign(edges, INVALID_INDEX);
+        triangles.reserve(6 * count);
+        for (std::uint32_t d = 0; d < edges; ++d)
+        {
+            const std::uint32_t e = 2 * d;
+            if (_org[d] == INVALID_INDEX || _face[d] != INVALID_INDEX) continue;
+            const std::uint32_t e1 = lnext(e);
+            const std::uint32_t e2 = lnext(e1);
+            if (lnext(e2) != e || orient(org(e), org(e1), org(e2)) <= 0) continue;
+
+            const std::uint32_t t = static_cast<std::uint32_t>(triangles.size());
+            _face[e >> 1] = t;
+            _face[e1 >> 1] = t + 1;
+            _face[e2 >> 1] = t + 2;
+            triangles.push_back(_sorted[org(e)]);
+            triangles.push_back(_sorted[org(e1)]);
+            triangles.push_back(_sorted[org(e2)]);
+        }
+
+        halfedges.resize(triangles.size());
+        for (std::uint32_t d = 0; d < edges; ++d)
+        {
+            if (_face[d] != INVALID_INDEX) halfedges[_face[d]] = _face[sym(2 * d) >> 1];
+        }
+    }
+
+    bool _parallel = false;
+    std::vector<std::uint32_t> _sorted;
+    std::vector<double> _x;
+    std::vector<double> _y;
+    std::vector<std::uint32_t> _onext;      //每个四边结构 4 项，依次为 e、rot(e)、sym(e)、rotInv(e) 的 onext
+    std::vector<std::uint32_t> _org;        //每个四边结构 2 项：原边与其反向边的起点，空闲时为 INVALID_INDEX
+    std::vector<std::uint32_t> _face;       //每条有向原边在 triangles 中的位置，不属于三角形时为 INVALID_INDEX
+};
+
+#endif
@@ -11,7 +11,7 @@ public:
 
     using VertexType = Vector2<T>;  
 
-    //캯
+    //构造函数
     Edge(const VertexType& p1, const VertexType& p2) : p1(p1), p2(p2), isBad(false) {}
     Edge(const Edge& e) : p1(e.p1), p2(e.p2), isBad(false) {}
 
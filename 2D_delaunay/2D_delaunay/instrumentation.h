@@ -0,0 +1,202 @@
+#pragma once
+#ifndef H_INSTRUMENTATION
+#define H_INSTRUMENTATION
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+//Delaunay<T, Instrumentation> 的插桩策略。剖分在热点路径上调用策略的钩子：
+//  circleTest(exact)            每次外接圆检测，exact 表示缓存的误差界无法判定、改用精确谓词
+//  walkStep()                   点定位行走的每一步
+//  cavity(faces, edges)         每次插入，空腔（坏三角形）个数与空腔边界边数
+//  faceCount(live, stored)      每次插入之后，有效三角形数与三角形数组长度（含空闲链表中的位置）
+//  faceSlot(reused)             每次新建三角形，reused 表示复用了空闲链表中的位置，否则追加到数组末尾
+//  phase(name, begin, end)      一个阶段结束（与 lastPhaseTimes 的划分相同）
+//  merge(other)                 并行剖分中汇总条带与接缝的子剖分
+//默认的 NoInstrumentation 全部是空的内联函数，编译后不留下任何代码
+
+struct NoInstrumentation
+{
+    using Clock = std::chrono::steady_clock;
+
+    void circleTest(bool) {}
+    void walkStep() {}
+    void cavity(std::size_t, std::size_t) {}
+    void faceCount(std::size_t, std::size_t) {}
+    void faceSlot(bool) {}
+    void phase(const char*, Clock::time_point, Clock::time_point) {}
+    void merge(const NoInstrumentation&) {}
+};
+
+//计数：统计热点路径上各种操作的次数，结果在多次剖分之间累计，需要时赋值为 {} 清零
+struct CountingInstrumentation
+{
+    using Clock = std::chrono::steady_clock;
+
+    //空腔大小直方图的桶数，最后一个桶包含所有更大的空腔
+    static constexpr std::size_t CAVITY_BUCKETS = 32;
+
+    std::uint64_t circleTests = 0;
+    std::uint64_t exactCircleTests = 0;
+    std::uint64_t walkSteps = 0;
+    std::uint64_t insertions = 0;
+    std::uint64_t cavityFaces = 0;
+    std::uint64_t boundaryEdges = 0;
+    std::uint64_t reusedFaces = 0;
+    std::uint64_t appendedFaces = 0;
+    std::size_t peakLiveFaces = 0;
+    std::size_t peakStoredFaces = 0;
+    std::uint64_t cavityHistogram[CAVITY_BUCKETS] = {};
+
+    void circleTest(bool exact)
+    {
+        ++circleTests;
+        if (exact) ++exactCircleTests;
+    }
+
+    void walkStep() { ++walkSteps; }
+
+    void cavity(std::size_t faces, std::size_t edges)
+    {
+        ++insertions;
+        cavityFaces += faces;
+        boundaryEdges += edges;
+        ++cavityHistogram[std::min(faces, CAVITY_BUCKETS - 1)];
+    }
+
+    void faceCount(std::size_t live, std::size_t stored)
+    {
+        peakLiveFaces = std::max(peakLiveFaces, live);
+        peakStoredFaces = std::max(peakStoredFaces, stored);
+    }
+
+    void faceSlot(bool reused)
+    {
+        if (reused) ++reusedFaces;
+        else ++appendedFaces;
+    }
+
+    void phase(const char*, Clock::time_point, Clock::time_point) {}
+
+    void merge(const CountingInstrumentation& other)
+    {
+        circleTests += other.circleTests;
+        exactCircleTests += other.exactCircleTests;
+        walkSteps += other.walkSteps;
+        insertions += other.insertions;
+        cavityFaces += other.cavityFaces;
+        boundaryEdges += other.boundaryEdges;
+        reusedFaces += other.reusedFaces;
+        appendedFaces += other.appendedFaces;
+        peakLiveFaces = std::max(peakLiveFaces, other.peakLiveFaces);
+        peakStoredFaces = std::max(peakStoredFaces, other.peakStoredFaces);
+        for (std::size_t k = 0; k < CAVITY_BUCKETS; ++k) cavityHistogram[k] += other.cavityHistogram[k];
+    }
+
+    void report(std::ostream& out) const
+    {
+        const double n = insertions ? double(insertions) : 1.0;
+        out << "插入点数: " << insertions << std::endl;
+        out << "外接圆检测: " << circleTests << "（每点 " << circleTests / n << "），其中精确谓词: " << exactCircleTests << std::endl;
+        out << "定位行走步数: " << walkSteps << "（每点 " << walkSteps / n << "）" << std::endl;
+        out << "空腔三角形: 每点 " << cavityFaces / n << "，空腔边界边: 每点 " << boundaryEdges / n << std::endl;
+        out << "新建三角形: 复用空闲位置 " << reusedFaces << " 个，追加到数组末尾 " << appendedFaces << " 个" << std::endl;
+        out << "有效三角形峰值: " << peakLiveFaces << "，数组长度峰值: " << peakStoredFaces << std::endl;
+        out << "空腔大小直方图（三角形数: 插入次数）:";
+        for (std::size_t k = 0; k < CAVITY_BUCKETS; ++k)
+        {
+            if (cavityHistogram[k]) out << " " << k << (k + 1 == CAVITY_BUCKETS ? "+" : "") << ":" << cavityHistogram[k];
+        }
+        out << std::endl;
+    }
+};
+
+//追踪：在计数之外记录各阶段的时间线和三角形数的变化，
+//saveTrace 写出 Chrome trace 格式的 JSON，可在 chrome://tracing 或 Perfetto 中查看
+struct TracingInstrumentation : CountingInstrumentation
+{
+    //每隔多少次插入记录一次三角形数
+    static constexpr std::uint64_t COUNTER_INTERVAL = 1024;
+
+    struct Event
+    {
+        const char* name;
+        char type;              //'X' 阶段，'C' 计数器
+        std::int64_t begin;     //steady_clock 纳秒
+        std::int64_t duration;
+        std::uint32_t thread;
+        std::uint64_t value;
+    };
+
+    std::vector<Event> events;
+
+    void faceCount(std::size_t live, std::size_t stored)
+    {
+        CountingInstrumentation::faceCount(live, stored);
+        if (insertions % COUNTER_INTERVAL == 0) events.push_back(Event{ "faces", 'C', now(), 0, threadIndex(), live });
+    }
+
+    void phase(const char* name, Clock::time_point begin, Clock::time_point end)
+    {
+        events.push_back(Event{ name, 'X', nanoseconds(begin), nanoseconds(end) - nanoseconds(begin), threadIndex(), 0 });
+    }
+
+    void merge(const TracingInstrumentation& other)
+    {
+        CountingInstrumentation::merge(other);
+        events.insert(events.end(), other.events.begin(), other.events.end());
+    }
+
+    bool saveTrace(const std::string& filename) const
+    {
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "无法创建文件: " << filename << std::endl;
+            return false;
+        }
+
+        //时间戳以最早的事件为零点，单位为微秒
+        std::int64_t origin = events.empty() ? 0 : events[0].begin;
+        for (const Event& e : events) origin = std::min(origin, e.begin);
+
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (std::size_t k = 0; k < events.size(); ++k)
+        {
+            const Event& e = events[k];
+            file << (k ? ",\n" : "\n") << "{\"name\":\"" << e.name << "\",\"ph\":\"" << e.type
+                << "\",\"pid\":1,\"tid\":" << e.thread << ",\"ts\":" << (e.begin - origin) / 1000.0;
+            if (e.type == 'X') file << ",\"dur\":" << e.duration / 1000.0;
+            if (e.type == 'C') file << ",\"args\":{\"live\":" << e.value << "}";
+            file << "}";
+        }
+        file << "\n]}\n";
+        return bool(file);
+    }
+
+private:
+    static std::int64_t nanoseconds(Clock::time_point t)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    static std::int64_t now() { return nanoseconds(Clock::now()); }
+
+    //线程的短编号，作为时间线上的 tid
+    static std::uint32_t threadIndex()
+    {
+        static std::atomic<std::uint32_t> next(0);
+        thread_local const std::uint32_t index = next++;
+        return index;
+    }
+};
+
+#endif
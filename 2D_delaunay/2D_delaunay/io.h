@@ -4,10 +4,11 @@
 #include "vector2.h"
 #include "edge.h"
 #include "triangle.h"
+#include "text_parser.h"
+#include "thread_pool.h"
 #include <vector>
 #include <string>
 #include <fstream>
-#include <sstream>
 #include <sys/stat.h>
 #include <random>
 #ifdef _WIN32
@@ -16,7 +17,7 @@
 
 class FileIO {
 public:
-    // ƽ̨Ŀ¼
+    // 跨平台目录创建函数
     static bool createDirectory(const std::string& path) {
 #ifdef _WIN32
         return _mkdir(path.c_str()) == 0;
@@ -25,21 +26,21 @@ public:
 #endif
     }
 
-    // ݹ鴴Ŀ¼
+    // 递归创建目录
     static bool createDirectories(const std::string& path) {
-        // ȼĿ¼ǷѴ
+        // 先检查目录是否已存在
         struct stat info;
         if (stat(path.c_str(), &info) == 0) {
             if (info.st_mode & S_IFDIR) {
                 return true;
             }
             else {
-                std::cerr << "·ڵĿ¼: " << path << std::endl;
+                std::cerr << "路径存在但不是目录: " << path << std::endl;
                 return false;
             }
         }
 
-        // ݹ鴴Ŀ¼
+        // 递归创建父目录
         size_t pos = path.find_last_of('/');
         if (pos != std::string::npos) {
             std::string parent = path.substr(0, pos);
@@ -48,60 +49,88 @@ public:
             }
         }
 
-        // ǰĿ¼
-        return createDirectory(path);
+        // 创建当前目录；失败时可能是其他线程刚刚创建了它
+        return createDirectory(path) || pathExists(path);
     }
 
-    // ļĿ¼Ƿ
+    // 检查文件或目录是否存在
     static bool pathExists(const std::string& path) {
         struct stat info;
         return stat(path.c_str(), &info) == 0;
     }
 
-    // ȡݴļ
-    static std::vector<Vector2<float>> readPointsFromFile(const std::string& filename) {
+    // 解析一行 "x y"，行首不是两个数字时返回 false
+    static bool parsePointLine(const char* first, const char* last, Vector2<float>& p) {
+        return textparse::parseNumber(first, last, p.x) && textparse::parseNumber(first, last, p.y);
+    }
+
+    // 读取点数据从文件；给出线程池时各块并行解析，verbose 为 false 时不输出读取信息（错误仍输出到 cerr）
+    static std::vector<Vector2<float>> readPointsFromFile(const std::string& filename, ThreadPool* pool = nullptr,
+        bool verbose = true) {
         std::vector<Vector2<float>> points;
 
         if (!pathExists(filename)) {
-            std::cerr << "ļ: " << filename << std::endl;
+            std::cerr << "文件不存在: " << filename << std::endl;
             return points;
         }
 
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "޷ļ: " << filename << std::endl;
+        const bool opened = textparse::parseLines(filename, points,
+            [](const char* first, const char* last, std::vector<Vector2<float>>& out) {
+                Vector2<float> p;
+                if (parsePointLine(first, last, p)) {
+                    out.push_back(p);
+                }
+            }, pool);
+        if (!opened) {
+            std::cerr << "无法打开文件: " << filename << std::endl;
             return points;
         }
 
-        std::string line;
-        while (std::getline(file, line)) {
-            std::istringstream iss(line);
-            float x, y;
-            if (iss >> x >> y) {
-                points.push_back(Vector2<float>(x, y));
-            }
+        if (verbose) {
+            std::cout << "从 " << filename << " 读取了 " << points.size() << " 个点" << std::endl;
         }
-
-        file.close();
-        std::cout << " " << filename << " ȡ " << points.size() << " " << std::endl;
         return points;
     }
 
-    // 㵽ļ
+    // 逐行读取点文件并对每个点调用 f，不在内存中保存点集，用于比内存还大的文件；返回读到的点数
+    // f 按文件中的顺序串行调用（流式插入依赖这个顺序），所以这里不接受线程池
+    template <class F>
+    static std::size_t forEachPoint(const std::string& filename, F&& f) {
+        textparse::ChunkReader reader(filename);
+        if (!reader.isOpen()) {
+            std::cerr << "无法打开文件: " << filename << std::endl;
+            return 0;
+        }
+
+        std::size_t count = 0;
+        std::vector<char> block;
+        while (reader.next(block)) {
+            textparse::forEachLine(block.data(), block.data() + block.size(), [&](const char* first, const char* last) {
+                Vector2<float> p;
+                if (parsePointLine(first, last, p)) {
+                    f(p);
+                    ++count;
+                }
+            });
+        }
+        return count;
+    }
+
+    // 保存点到文件
     static bool savePointsToFile(const std::vector<Vector2<float>>& points, const std::string& filename) {
-        // ȷĿ¼
+        // 确保目录存在
         size_t lastSlash = filename.find_last_of('/');
         if (lastSlash != std::string::npos) {
             std::string dir = filename.substr(0, lastSlash);
             if (!createDirectories(dir)) {
-                std::cerr << "޷Ŀ¼: " << dir << std::endl;
+                std::cerr << "无法创建目录: " << dir << std::endl;
                 return false;
             }
         }
 
         std::ofstream file(filename);
         if (!file.is_open()) {
-            std::cerr << "޷ļ: " << filename << std::endl;
+            std::cerr << "无法创建文件: " << filename << std::endl;
             return false;
         }
 
@@ -110,25 +139,25 @@ public:
         }
 
         file.close();
-        std::cout << "ݱ浽: " << filename << std::endl;
+        std::cout << "点数据保存到: " << filename << std::endl;
         return true;
     }
 
-    // ߵļ
-    static bool saveEdgesToFile(const std::vector<Edge<float>>& edges, const std::string& filename) {
-        // ȷĿ¼
+    // 保存边到文件，verbose 为 false 时不输出保存信息
+    static bool saveEdgesToFile(const std::vector<Edge<float>>& edges, const std::string& filename, bool verbose = true) {
+        // 确保目录存在
         size_t lastSlash = filename.find_last_of('/');
         if (lastSlash != std::string::npos) {
             std::string dir = filename.substr(0, lastSlash);
             if (!createDirectories(dir)) {
-                std::cerr << "޷Ŀ¼: " << dir << std::endl;
+                std::cerr << "无法创建目录: " << dir << std::endl;
                 return false;
             }
         }
 
         std::ofstream file(filename);
         if (!file.is_open()) {
-            std::cerr << "޷ļ: " << filename << std::endl;
+            std::cerr << "无法创建文件: " << filename << std::endl;
             return false;
         }
 
@@ -137,25 +166,28 @@ public:
         }
 
         file.close();
-        std::cout << "ݱ浽: " << filename << std::endl;
+        if (verbose) {
+            std::cout << "边数据保存到: " << filename << std::endl;
+        }
         return true;
     }
 
-    // εļ
-    static bool saveTrianglesToFile(const std::vector<Triangle<float>>& triangles, const std::string& filename) {
-        // ȷĿ¼
+    // 保存三角形到文件，verbose 为 false 时不输出保存信息
+    static bool saveTrianglesToFile(const std::vector<Triangle<float>>& triangles, const std::string& filename,
+        bool verbose = true) {
+        // 确保目录存在
         size_t lastSlash = filename.find_last_of('/');
         if (lastSlash != std::string::npos) {
             std::string dir = filename.substr(0, lastSlash);
             if (!createDirectories(dir)) {
-                std::cerr << "޷Ŀ¼: " << dir << std::endl;
+                std::cerr << "无法创建目录: " << dir << std::endl;
                 return false;
             }
         }
 
         std::ofstream file(filename);
         if (!file.is_open()) {
-            std::cerr << "޷ļ: " << filename << std::endl;
+            std::cerr << "无法创建文件: " << filename << std::endl;
             return false;
         }
 
@@ -166,45 +198,13 @@ public:
         }
 
         file.close();
-        std::cout << "ݱ浽: " << filename << std::endl;
-        return true;
-    }
-
-    // ͳϢļ
-    static bool saveStatisticsToFile(int fileNum, int pointCount, int triangleCount, int edgeCount,
-        long long duration, const std::string& filename) {
-        // ȷĿ¼
-        size_t lastSlash = filename.find_last_of('/');
-        if (lastSlash != std::string::npos) {
-            std::string dir = filename.substr(0, lastSlash);
-            if (!createDirectories(dir)) {
-                std::cerr << "޷Ŀ¼: " << dir << std::endl;
-                return false;
-            }
+        if (verbose) {
+            std::cout << "三角形数据保存到: " << filename << std::endl;
         }
-
-        std::ofstream file(filename, std::ios::app); // ׷ģʽ
-        if (!file.is_open()) {
-            std::cerr << "޷ļ: " << filename << std::endl;
-            return false;
-        }
-
-        // ǵһд룬ӱ
-        static bool firstWrite = true;
-        if (firstWrite) {
-            file << "ļ,,,,ʱ()\n";
-            firstWrite = false;
-        }
-
-        file << fileNum << "," << pointCount << "," << triangleCount << ","
-            << edgeCount << "," << duration << "\n";
-
-        file.close();
-        std::cout << "ͳϢ浽: " << filename << std::endl;
         return true;
     }
 
-    // ά
+    // 生成随机二维点
     static float RandomFloat(float a, float b) {
         static std::random_device rd;
         static std::mt19937 gen(rd());
@@ -212,7 +212,7 @@ public:
         return dis(gen);
     }
 
-    // 㼯
+    // 生成随机点集
     static std::vector<Vector2<float>> generateRandomPoints(int count) {
         std::vector<Vector2<float>> points;
 
@@ -220,21 +220,21 @@ public:
             points.push_back(Vector2<float>(RandomFloat(0, 800), RandomFloat(0, 600)));
         }
 
-        std::cout << " " << points.size() << " " << std::endl;
+        std::cout << "生成了 " << points.size() << " 个随机点" << std::endl;
         return points;
     }
 
-    // 1-10ļ
+    // 生成1-10的数据文件
     static bool generateDataFiles() {
-        std::cout << "ʼ1-10ļ..." << std::endl;
+        std::cout << "开始生成1-10的数据文件..." << std::endl;
 
-        // ȷdataĿ¼
+        // 确保data目录存在
         if (!createDirectories("../data")) {
-            std::cerr << "޷dataĿ¼" << std::endl;
+            std::cerr << "无法创建data目录" << std::endl;
             return false;
         }
 
-        // Ϊÿļɲͬĵ
+        // 为每个文件生成不同数量的点
         std::vector<int> pointCounts = { 20, 30, 40, 50, 60, 70, 80, 90, 100, 110 };
 
         for (int i = 1; i <= 10; ++i) {
@@ -244,14 +244,14 @@ public:
             std::vector<Vector2<float>> points = generateRandomPoints(pointCount);
 
             if (!savePointsToFile(points, filename)) {
-                std::cerr << "ļ " << i << " ʧ" << std::endl;
+                std::cerr << "生成文件 " << i << " 失败" << std::endl;
                 return false;
             }
 
-            std::cout << "ļ " << i << " ɣ " << pointCount << " " << std::endl;
+            std::cout << "生成文件 " << i << " 完成，包含 " << pointCount << " 个点" << std::endl;
         }
 
-        std::cout << "ļ" << std::endl;
+        std::cout << "所有数据文件生成完成" << std::endl;
         return true;
     }
 };
@@ -0,0 +1,84 @@
+#pragma once
+#ifndef H_MESH
+#define H_MESH
+
+#include "vector2.h"
+#include "point_view.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//紧凑的索引网格：坐标只保存一份，三角形和邻接关系都用 uint32 索引表示
+template <class T>
+struct IndexedMesh
+{
+    using VertexType = Vector2<T>;
+
+    //无效索引，表示该边位于凸包上，外侧没有三角形
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    //顶点坐标，引用剖分时传入的点（或剖分对象内部的点），不做拷贝；三角形中的编号就是这些点的编号
+    PointView<T> vertices;
+    std::size_t vertexCount = 0;
+
+    //每 3 个索引组成一个逆时针三角形
+    std::vector<std::uint32_t> triangles;
+
+    //neighbors[3 * t + i] 为三角形 t 的边 (i, i + 1) 外侧的三角形编号
+    std::vector<std::uint32_t> neighbors;
+
+    std::size_t triangleCount() const { return triangles.size() / 3; }
+
+    VertexType vertex(std::uint32_t i) const { return vertices[i]; }
+
+    //三角形 t 的第 i 个顶点
+    std::uint32_t corner(std::size_t t, int i) const { return triangles[3 * t + i]; }
+
+    //三角形 t 的第 i 条边外侧的三角形
+    std::uint32_t neighbor(std::size_t t, int i) const { return neighbors[3 * t + i]; }
+
+    //每条边只输出一次：内部边由编号较小的三角形输出，凸包边直接输出
+    std::vector<std::uint32_t> uniqueEdges() const
+    {
+        std::vector<std::uint32_t> edges;
+        edges.reserve(triangles.size() + 3);
+        for (std::size_t t = 0; t < triangleCount(); ++t)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                const std::uint32_t n = neighbor(t, i);
+                if (n == INVALID_INDEX || n > t)
+                {
+                    edges.push_back(corner(t, i));
+                    edges.push_back(corner(t, (i + 1) % 3));
+                }
+            }
+        }
+        return edges;
+    }
+
+    //不重复的边数，与 uniqueEdges 一致：内部边被两个三角形共用，凸包边只属于一个三角形
+    std::size_t edgeCount() const
+    {
+        std::size_t boundary = 0;
+        for (const std::uint32_t n : neighbors) boundary += n == INVALID_INDEX;
+        return (neighbors.size() + boundary) / 2;
+    }
+
+    //网格本身占用的字节数（不含共享的顶点坐标）
+    std::size_t memoryBytes() const
+    {
+        return (triangles.capacity() + neighbors.capacity()) * sizeof(std::uint32_t);
+    }
+
+    void clear()
+    {
+        vertices = PointView<T>();
+        vertexCount = 0;
+        triangles.clear();
+        neighbors.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,255 @@
+#pragma once
+#ifndef H_MESH_FILE
+#define H_MESH_FILE
+
+#include "vector2.h"
+#include "mesh.h"
+#include "io.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+//二进制索引网格文件的文件头（32 字节，小端），其后依次为：
+//  顶点表：vertexCount 个点，每个点为 precision 字节的 x、y；
+//  三角形：未压缩时每个三角形为 3 个 uint32 顶点编号；压缩时每个三角形为 3 个变长整数，
+//  依次是第一个顶点相对上一个三角形第一个顶点的差、另两个顶点相对第一个顶点的差（均为 zigzag 编码）。
+//相邻三角形的编号很接近，压缩后大多数差值只需要 1 到 2 个字节
+struct MeshFileHeader
+{
+    char magic[4];              //"MS2D"
+    std::uint32_t version;      //当前为 1
+    std::uint32_t precision;    //单个坐标的字节数：4 为 float，8 为 double
+    std::uint32_t flags;        //MESH_FILE_COMPRESSED 表示三角形做了差分和变长编码
+    std::uint64_t vertexCount;
+    std::uint64_t triangleCount;
+};
+
+static_assert(sizeof(MeshFileHeader) == 32, "MeshFileHeader must be 32 bytes");
+
+static constexpr std::uint32_t MESH_FILE_COMPRESSED = 1;
+
+//带大缓冲区的二进制写入：数据先攒在缓冲区里，满了再整块写出，避免大量小块的流操作
+class BufferedWriter
+{
+public:
+    explicit BufferedWriter(const std::string& filename, std::size_t bufferBytes = 1u << 20)
+        : _file(filename, std::ios::binary)
+    {
+        _buffer.reserve(bufferBytes);
+    }
+
+    ~BufferedWriter() { flush(); }
+
+    bool isOpen() const { return _file.is_open(); }
+
+    void write(const void* data, std::size_t bytes)
+    {
+        if (_buffer.size() + bytes > _buffer.capacity())
+        {
+            flush();
+            if (bytes > _buffer.capacity())
+            {
+                _file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+                return;
+            }
+        }
+        const char* p = static_cast<const char*>(data);
+        _buffer.insert(_buffer.end(), p, p + bytes);
+    }
+
+    //LEB128 变长整数：每字节 7 位数据，最高位表示后面还有字节
+    void writeVarint(std::uint32_t v)
+    {
+        if (_buffer.size() + 5 > _buffer.capacity()) flush();
+        while (v >= 0x80)
+        {
+            _buffer.push_back(static_cast<char>((v & 0x7F) | 0x80));
+            v >>= 7;
+        }
+        _buffer.push_back(static_cast<char>(v));
+    }
+
+    //把缓冲区写入文件，返回到目前为止是否全部写入成功
+    bool flush()
+    {
+        if (!_buffer.empty()) _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+        _file.flush();
+        return bool(_file);
+    }
+
+private:
+    std::ofstream _file;
+    std::vector<char> _buffer;
+};
+
+inline std::uint32_t zigzagEncode(std::int32_t v)
+{
+    return (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+}
+
+inline std::int32_t zigzagDecode(std::uint32_t v)
+{
+    return static_cast<std::int32_t>(v >> 1) ^ -static_cast<std::int32_t>(v & 1);
+}
+
+//把索引网格写成二进制文件：顶点表加三角形编号，compress 为 true 时三角形做差分 + 变长编码；
+//verbose 为 false 时不输出保存信息
+template <class T>
+bool saveMeshFile(const IndexedMesh<T>& mesh, const std::string& filename, bool compress = true, bool verbose = true)
+{
+    //确保目录存在
+    const std::size_t lastSlash = filename.find_last_of('/');
+    if (lastSlash != std::string::npos && !FileIO::createDirectories(filename.substr(0, lastSlash)))
+    {
+        std::cerr << "无法创建目录: " << filename.substr(0, lastSlash) << std::endl;
+        return false;
+    }
+
+    BufferedWriter out(filename);
+    if (!out.isOpen())
+    {
+        std::cerr << "无法创建文件: " << filename << std::endl;
+        return false;
+    }
+
+    MeshFileHeader h = {};
+    std::memcpy(h.magic, "MS2D", 4);
+    h.version = 1;
+    h.precision = sizeof(T);
+    h.flags = compress ? MESH_FILE_COMPRESSED : 0;
+    h.vertexCount = mesh.vertexCount;
+    h.triangleCount = mesh.triangleCount();
+    out.write(&h, sizeof(h));
+    //顶点本来就是连续的 Vector2 数组时整块写出，否则（SoA、记录数组）逐个点写出
+    if (const Vector2<T>* block = mesh.vertices.contiguous())
+    {
+        out.write(block, mesh.vertexCount * sizeof(Vector2<T>));
+    }
+    else
+    {
+        for (std::size_t i = 0; i < mesh.vertexCount; ++i)
+        {
+            const T xy[2] = { mesh.vertices.x(i), mesh.vertices.y(i) };
+            out.write(xy, sizeof(xy));
+        }
+    }
+
+    if (!compress)
+    {
+        out.write(mesh.triangles.data(), mesh.triangles.size() * sizeof(std::uint32_t));
+    }
+    else
+    {
+        std::uint32_t previous = 0;
+        for (std::size_t t = 0; t < mesh.triangleCount(); ++t)
+        {
+            const std::uint32_t a = mesh.corner(t, 0);
+            out.writeVarint(zigzagEncode(static_cast<std::int32_t>(a - previous)));
+            out.writeVarint(zigzagEncode(static_cast<std::int32_t>(mesh.corner(t, 1) - a)));
+            out.writeVarint(zigzagEncode(static_cast<std::int32_t>(mesh.corner(t, 2) - a)));
+            previous = a;
+        }
+    }
+
+    if (!out.flush())
+    {
+        std::cerr << "写入文件失败: " << filename << std::endl;
+        return false;
+    }
+    if (verbose)
+    {
+        std::cout << "网格数据保存到: " << filename << std::endl;
+    }
+    return true;
+}
+
+//读取二进制网格文件，用于核对结果：vertices 为顶点表，triangles 每 3 个编号组成一个三角形
+template <class T>
+bool loadMeshFile(const std::string& filename, std::vector<Vector2<T>>& vertices, std::vector<std::uint32_t>& triangles)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "无法打开文件: " << filename << std::endl;
+        return false;
+    }
+
+    MeshFileHeader h;
+    if (!file.read(reinterpret_cast<char*>(&h), sizeof(h)) || std::memcmp(h.magic, "MS2D", 4) != 0 || h.version != 1)
+    {
+        std::cerr << "不是二进制网格文件: " << filename << std::endl;
+        return false;
+    }
+    if (h.precision != sizeof(T))
+    {
+        std::cerr << "网格文件的坐标精度为 " << h.precision << " 字节，与请求的 " << sizeof(T) << " 字节不符: " << filename << std::endl;
+        return false;
+    }
+
+    vertices.resize(static_cast<std::size_t>(h.vertexCount));
+    triangles.resize(static_cast<std::size_t>(3 * h.triangleCount));
+    file.read(reinterpret_cast<char*>(vertices.data()), static_cast<std::streamsize>(vertices.size() * sizeof(Vector2<T>)));
+
+    if (!(h.flags & MESH_FILE_COMPRESSED))
+    {
+        file.read(reinterpret_cast<char*>(triangles.data()), static_cast<std::streamsize>(triangles.size() * sizeof(std::uint32_t)));
+    }
+    else
+    {
+        //压缩部分一次读入，再在内存中解码
+        const std::streampos start = file.tellg();
+        file.seekg(0, std::ios::end);
+        std::vector<unsigned char> data(static_cast<std::size_t>(file.tellg() - start));
+        file.seekg(start);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        std::size_t pos = 0;
+        bool ok = true;
+        auto readVarint = [&]() {
+            std::uint32_t v = 0;
+            for (int shift = 0; shift < 35; shift += 7)
+            {
+                if (pos >= data.size())
+                {
+                    ok = false;
+                    return v;
+                }
+                const unsigned char b = data[pos++];
+                v |= static_cast<std::uint32_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return v;
+        };
+
+        std::uint32_t previous = 0;
+        for (std::size_t i = 0; i < triangles.size() && ok; i += 3)
+        {
+            const std::uint32_t a = previous + static_cast<std::uint32_t>(zigzagDecode(readVarint()));
+            triangles[i] = a;
+            triangles[i + 1] = a + static_cast<std::uint32_t>(zigzagDecode(readVarint()));
+            triangles[i + 2] = a + static_cast<std::uint32_t>(zigzagDecode(readVarint()));
+            previous = a;
+        }
+        if (!ok)
+        {
+            std::cerr << "网格文件已损坏: " << filename << std::endl;
+            return false;
+        }
+    }
+
+    if (!file)
+    {
+        std::cerr << "网格文件长度不足: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#endif
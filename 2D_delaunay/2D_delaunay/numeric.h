@@ -5,7 +5,7 @@
 #include <cmath>
 #include <limits>
 
- //ĿľȽǷȣ float1 - float2  < 0.000001
+ //其目的就是用来比较数据是否相等，变相的 float1 - float2  < 0.000001
 template<class T>
 typename std::enable_if<!std::numeric_limits<T>::is_integer, bool>::type
 almost_equal(T x, T y, int ulp = 2)
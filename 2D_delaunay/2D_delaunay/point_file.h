@@ -0,0 +1,264 @@
+#pragma once
+#ifndef H_POINT_FILE
+#define H_POINT_FILE
+
+#include "vector2.h"
+#include "io.h"
+
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//二进制点文件的文件头（64 字节，小端）。其后紧跟 count 个点，每个点为 precision 字节的 x、y，
+//坐标区从第 64 字节开始，按 8 字节对齐，映射到内存后可以直接当作 Vector2<T> 数组使用
+struct PointFileHeader
+{
+    char magic[4];              //"PT2D"
+    std::uint32_t version;      //当前为 1
+    std::uint32_t precision;    //单个坐标的字节数：4 为 float，8 为 double
+    std::uint32_t reserved;
+    std::uint64_t count;        //点数
+    double minX, minY;          //包围盒
+    double maxX, maxY;
+    std::uint64_t reserved2;
+};
+
+static_assert(sizeof(PointFileHeader) == 64, "PointFileHeader must be 64 bytes");
+
+//只读映射一个二进制点文件：不解析、不拷贝，data() 直接指向映射的坐标区，由操作系统按需换页
+template <class T>
+class MappedPoints
+{
+public:
+    using VertexType = Vector2<T>;
+
+    static_assert(sizeof(VertexType) == 2 * sizeof(T), "Vector2<T> must be two packed coordinates");
+
+    MappedPoints() = default;
+    explicit MappedPoints(const std::string& filename) { open(filename); }
+    ~MappedPoints() { close(); }
+
+    MappedPoints(const MappedPoints&) = delete;
+    MappedPoints& operator=(const MappedPoints&) = delete;
+
+    //映射文件并校验文件头，失败时返回 false 并输出原因
+    bool open(const std::string& filename)
+    {
+        close();
+        if (!map(filename)) return false;
+
+        if (_bytes < sizeof(PointFileHeader))
+        {
+            std::cerr << "不是二进制点文件: " << filename << std::endl;
+            close();
+            return false;
+        }
+        const PointFileHeader& h = header();
+        if (std::memcmp(h.magic, "PT2D", 4) != 0 || h.version != 1)
+        {
+            std::cerr << "不是二进制点文件: " << filename << std::endl;
+            close();
+            return false;
+        }
+        if (h.precision != sizeof(T))
+        {
+            std::cerr << "点文件的坐标精度为 " << h.precision << " 字节，与请求的 " << sizeof(T) << " 字节不符: " << filename << std::endl;
+            close();
+            return false;
+        }
+        if ((_bytes - sizeof(PointFileHeader)) / sizeof(VertexType) < h.count)
+        {
+            std::cerr << "点文件长度不足: " << filename << std::endl;
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (_base) UnmapViewOfFile(_base);
+        if (_mapping) CloseHandle(_mapping);
+        if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+        _mapping = nullptr;
+        _file = INVALID_HANDLE_VALUE;
+#else
+        if (_base) munmap(_base, _bytes);
+#endif
+        _base = nullptr;
+        _bytes = 0;
+    }
+
+    bool isOpen() const { return _base != nullptr; }
+    const PointFileHeader& header() const { return *static_cast<const PointFileHeader*>(_base); }
+
+    const VertexType* data() const
+    {
+        return reinterpret_cast<const VertexType*>(static_cast<const char*>(_base) + sizeof(PointFileHeader));
+    }
+
+    std::size_t size() const { return _base ? static_cast<std::size_t>(header().count) : 0; }
+    const VertexType* begin() const { return data(); }
+    const VertexType* end() const { return data() + size(); }
+    const VertexType& operator[](std::size_t i) const { return data()[i]; }
+
+private:
+    bool map(const std::string& filename)
+    {
+#ifdef _WIN32
+        _file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+        {
+            std::cerr << "无法打开文件: " << filename << std::endl;
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0)
+        {
+            std::cerr << "不是二进制点文件: " << filename << std::endl;
+            close();
+            return false;
+        }
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        _base = _mapping ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        _bytes = static_cast<std::size_t>(size.QuadPart);
+#else
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "无法打开文件: " << filename << std::endl;
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            ::close(fd);
+            std::cerr << "不是二进制点文件: " << filename << std::endl;
+            return false;
+        }
+        _bytes = static_cast<std::size_t>(info.st_size);
+        void* base = mmap(nullptr, _bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        _base = base == MAP_FAILED ? nullptr : base;
+        //坐标会被顺序读完，提示内核提前读入
+        if (_base) madvise(_base, _bytes, MADV_SEQUENTIAL);
+#endif
+        if (!_base)
+        {
+            std::cerr << "无法映射文件: " << filename << std::endl;
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void* _base = nullptr;
+    std::size_t _bytes = 0;
+#ifdef _WIN32
+    HANDLE _file = INVALID_HANDLE_VALUE;
+    HANDLE _mapping = nullptr;
+#endif
+};
+
+//把 count 个点写成二进制点文件，包围盒在写入时计算
+template <class T>
+bool savePointFile(const Vector2<T>* points, std::size_t count, const std::string& filename)
+{
+    PointFileHeader h = {};
+    std::memcpy(h.magic, "PT2D", 4);
+    h.version = 1;
+    h.precision = sizeof(T);
+    h.count = count;
+    h.minX = h.minY = count ? std::numeric_limits<double>::infinity() : 0;
+    h.maxX = h.maxY = count ? -std::numeric_limits<double>::infinity() : 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        h.minX = std::min<double>(h.minX, points[i].x);
+        h.minY = std::min<double>(h.minY, points[i].y);
+        h.maxX = std::max<double>(h.maxX, points[i].x);
+        h.maxY = std::max<double>(h.maxY, points[i].y);
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "无法创建文件: " << filename << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    file.write(reinterpret_cast<const char*>(points), static_cast<std::streamsize>(count * sizeof(Vector2<T>)));
+    return bool(file);
+}
+
+//把文本点文件（每行 "x y"）转换为二进制点文件。逐行读取、分块写出，不把整个点集读入内存；
+//文件头在最后回填点数和包围盒。返回转换的点数，失败时返回 0
+template <class T>
+std::size_t convertPointFile(const std::string& textFile, const std::string& binaryFile)
+{
+    std::ofstream file(binaryFile, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "无法创建文件: " << binaryFile << std::endl;
+        return 0;
+    }
+
+    PointFileHeader h = {};
+    std::memcpy(h.magic, "PT2D", 4);
+    h.version = 1;
+    h.precision = sizeof(T);
+    h.minX = h.minY = std::numeric_limits<double>::infinity();
+    h.maxX = h.maxY = -std::numeric_limits<double>::infinity();
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    std::vector<Vector2<T>> block;
+    block.reserve(1 << 16);
+    auto flush = [&]() {
+        file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size() * sizeof(Vector2<T>)));
+        block.clear();
+    };
+    FileIO::forEachPoint(textFile, [&](const Vector2<float>& p) {
+        block.push_back(Vector2<T>(T(p.x), T(p.y)));
+        h.minX = std::min<double>(h.minX, p.x);
+        h.minY = std::min<double>(h.minY, p.y);
+        h.maxX = std::max<double>(h.maxX, p.x);
+        h.maxY = std::max<double>(h.maxY, p.y);
+        ++h.count;
+        if (block.size() == block.capacity()) flush();
+    });
+    flush();
+
+    if (h.count == 0)
+    {
+        h.minX = h.minY = h.maxX = h.maxY = 0;
+    }
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    if (!file)
+    {
+        std::cerr << "写入文件失败: " << binaryFile << std::endl;
+        return 0;
+    }
+    std::cout << "转换了 " << h.count << " 个点: " << textFile << " -> " << binaryFile << std::endl;
+    return static_cast<std::size_t>(h.count);
+}
+
+#endif
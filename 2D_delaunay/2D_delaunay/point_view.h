@@ -0,0 +1,71 @@
+#pragma once
+#ifndef H_POINT_VIEW
+#define H_POINT_VIEW
+
+#include "vector2.h"
+
+#include <cstddef>
+
+//只读的点视图：直接从调用方的数组中按编号读取坐标，不做拷贝。
+//第 i 个点的 x 位于 x 起始地址之后 i * stride 字节处，y 同理，因此一个视图可以表示
+//  连续的 Vector2 数组（stride 为 sizeof(Vector2<T>)）、
+//  x[]、y[] 分开存放的两个数组（结构体数组 SoA，stride 为 sizeof(T)）、
+//  带有其他字段的记录数组（stride 为一条记录的字节数）。
+//视图只保存地址，被引用的数组在使用视图期间必须保持有效、不被修改
+template <class T>
+class PointView
+{
+public:
+    using VertexType = Vector2<T>;
+
+    PointView() = default;
+
+    //连续的 Vector2 数组
+    PointView(const VertexType* points, std::size_t count)
+        : PointView(&points->x, &points->y, sizeof(VertexType), count)
+    {
+    }
+
+    //第一个点的 x、y 地址，以及相邻两个点之间的字节数
+    PointView(const T* x, const T* y, std::size_t stride, std::size_t count)
+        : _x(reinterpret_cast<const char*>(x)), _y(reinterpret_cast<const char*>(y)), _stride(stride), _count(count)
+    {
+    }
+
+    //x、y 分开存放的两个数组
+    static PointView soa(const T* x, const T* y, std::size_t count)
+    {
+        return PointView(x, y, sizeof(T), count);
+    }
+
+    //记录数组，x、y 为记录中坐标字段的成员指针，例如 PointView<float>::records(atoms, n, &Atom::x, &Atom::y)
+    template <class Record>
+    static PointView records(const Record* records, std::size_t count, T Record::* x, T Record::* y)
+    {
+        return PointView(&(records->*x), &(records->*y), sizeof(Record), count);
+    }
+
+    std::size_t size() const { return _count; }
+    bool empty() const { return _count == 0; }
+
+    T x(std::size_t i) const { return *reinterpret_cast<const T*>(_x + i * _stride); }
+    T y(std::size_t i) const { return *reinterpret_cast<const T*>(_y + i * _stride); }
+
+    VertexType operator[](std::size_t i) const { return VertexType(x(i), y(i)); }
+
+    //视图是否就是一个连续的 Vector2 数组：是时返回首地址，可以整块读写，否则返回空指针
+    const VertexType* contiguous() const
+    {
+        if (_count == 0 || _stride != sizeof(VertexType) || _y != _x + offsetof(VertexType, y) - offsetof(VertexType, x))
+            return nullptr;
+        return reinterpret_cast<const VertexType*>(_x - offsetof(VertexType, x));
+    }
+
+private:
+    const char* _x = nullptr;
+    const char* _y = nullptr;
+    std::size_t _stride = 0;
+    std::size_t _count = 0;
+};
+
+#endif
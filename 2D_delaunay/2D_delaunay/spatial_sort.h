@@ -0,0 +1,125 @@
+#pragma once
+#ifndef H_SPATIAL_SORT
+#define H_SPATIAL_SORT
+
+#include "vector2.h"
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+#include <cstddef>
+
+//点 (x, y) 在 2^16 x 2^16 网格上的 Hilbert 曲线序号，曲线上相邻的格子在平面上也相邻。
+//从高位到低位每层取一位 x、一位 y，查表得到本层的两位序号和下一层的坐标变换，循环内没有分支
+inline std::uint32_t hilbertIndex(std::uint32_t x, std::uint32_t y)
+{
+    //下标为 状态 * 4 + 象限，状态的高位表示 x、y 是否交换，低位表示是否取反；
+    //表项低 2 位是本层的序号，高 2 位是下一层的状态
+    static const std::uint8_t table[16] = { 8, 1, 15, 2, 6, 11, 5, 12, 0, 7, 9, 10, 14, 13, 3, 4 };
+    std::uint32_t state = 0;
+    std::uint32_t d = 0;
+    for (int level = 15; level >= 0; --level)
+    {
+        const std::uint32_t quadrant = (((x >> level) & 1) << 1) | ((y >> level) & 1);
+        const std::uint32_t t = table[(state << 2) | quadrant];
+        d = (d << 2) | (t & 3);
+        state = t >> 2;
+    }
+    return d;
+}
+
+//对 [first, last) 按高 32 位做稳定的基数排序（每趟 11 位，共 3 趟），buffer 至少与区间一样长
+inline void radixSortHigh32(std::uint64_t* first, std::uint64_t* last, std::uint64_t* buffer)
+{
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    std::uint64_t* src = first;
+    std::uint64_t* dst = buffer;
+    std::vector<std::size_t> count(2048 + 1);
+    for (int shift = 32; shift < 64; shift += 11)
+    {
+        std::fill(count.begin(), count.end(), 0);
+        for (std::size_t k = 0; k < n; ++k) ++count[((src[k] >> shift) & 2047) + 1];
+        for (std::size_t d = 0; d < 2048; ++d) count[d + 1] += count[d];
+        for (std::size_t k = 0; k < n; ++k) dst[count[(src[k] >> shift) & 2047]++] = src[k];
+        std::swap(src, dst);
+    }
+    if (src != first) std::copy(src, src + n, first);
+}
+
+//BRIO（有偏随机插入顺序）：每个点以 3/4 的概率分到最后一轮，其余的再以 3/4 的概率分到倒数第二轮……
+//各轮按从小到大的顺序插入，轮内按 Hilbert 曲线排序。轮与轮之间保持随机插入的期望复杂度，
+//轮内相邻插入的点在空间上靠近，点定位的行走很短，访问的三角形和坐标大多还在缓存里。
+//points 为 Vector2 数组或 PointView，返回值的第 k 项是第 k 个插入的点在 points 中的编号
+template <class Points>
+std::vector<std::uint32_t> brioOrder(const Points& points, std::uint32_t seed = 1)
+{
+    const std::size_t n = points.size();
+    std::vector<std::uint32_t> order(n);
+    if (n == 0) return order;
+
+    double minX = points[0].x, minY = points[0].y;
+    double maxX = minX, maxY = minY;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto p = points[i];
+        minX = std::min<double>(minX, p.x);
+        minY = std::min<double>(minY, p.y);
+        maxX = std::max<double>(maxX, p.x);
+        maxY = std::max<double>(maxY, p.y);
+    }
+    const double extent = std::max(maxX - minX, maxY - minY);
+    const double scale = extent > 0 ? 65535.0 / extent : 0.0;
+    auto quantize = [scale](double v) {
+        const double q = v * scale;
+        return q <= 0 ? 0u : q >= 65535.0 ? 65535u : static_cast<std::uint32_t>(q);
+    };
+
+    //轮数：最先插入的一轮期望不少于 64 个点
+    int levels = 1;
+    while (levels < 16 && (n >> (2 * levels)) >= 64) ++levels;
+
+    //固定种子，同一组点每次得到相同的顺序
+    std::mt19937 gen(seed);
+    std::vector<std::uint8_t> level(n);
+    std::vector<std::size_t> start(levels, 0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::uint32_t r = gen();
+        int l = 0;
+        while (l + 1 < levels && (r & 3) == 0)
+        {
+            r >>= 2;
+            ++l;
+        }
+        level[i] = static_cast<std::uint8_t>(l);
+        ++start[l];
+    }
+
+    //轮次高的先插入；高 32 位放曲线序号，低 32 位放点编号，同一轮内按编号递增写入
+    std::size_t offset = 0;
+    for (int l = levels - 1; l >= 0; --l)
+    {
+        const std::size_t count = start[l];
+        start[l] = offset;
+        offset += count;
+    }
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::uint64_t h = hilbertIndex(quantize(points[i].x - minX), quantize(points[i].y - minY));
+        keys[start[level[i]]++] = (h << 32) | i;
+    }
+
+    std::vector<std::uint64_t> buffer(n);
+    std::size_t first = 0;
+    for (int l = levels - 1; l >= 0; --l)
+    {
+        radixSortHigh32(keys.data() + first, keys.data() + start[l], buffer.data());
+        first = start[l];
+    }
+    for (std::size_t k = 0; k < n; ++k) order[k] = static_cast<std::uint32_t>(keys[k]);
+    return order;
+}
+
+#endif
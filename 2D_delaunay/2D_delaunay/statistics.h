@@ -0,0 +1,96 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include "io.h"
+#include <vector>
+#include <string>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+
+// 单个文件的剖分统计
+struct FileStatistics {
+    std::string name;           // 文件名（批处理）或文件编号
+    std::size_t pointCount = 0;
+    std::size_t triangleCount = 0;
+    std::size_t edgeCount = 0;
+    long long duration = 0;     // 三角剖分耗时（纳秒）
+};
+
+// 线程安全的统计汇总：各线程处理完一个文件后调用 add，全部结束后一次性写出 CSV。
+// 同一次运行的结果写在同一个文件里，标题行只写一次
+class StatisticsAggregator {
+public:
+    void add(const FileStatistics& record) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _records.push_back(record);
+    }
+
+    // 按文件名排序的全部记录，与完成的先后顺序无关
+    std::vector<FileStatistics> records() const {
+        std::vector<FileStatistics> result;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            result = _records;
+        }
+        std::sort(result.begin(), result.end(), [](const FileStatistics& a, const FileStatistics& b) {
+            return a.name.size() != b.name.size() ? a.name.size() < b.name.size() : a.name < b.name;
+        });
+        return result;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _records.size();
+    }
+
+    // 所有记录的合计，name 为空
+    FileStatistics total() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        FileStatistics sum;
+        for (const FileStatistics& r : _records) {
+            sum.pointCount += r.pointCount;
+            sum.triangleCount += r.triangleCount;
+            sum.edgeCount += r.edgeCount;
+            sum.duration += r.duration;
+        }
+        return sum;
+    }
+
+    // 保存统计信息到 CSV 文件（覆盖旧文件）
+    bool save(const std::string& filename) const {
+        // 确保目录存在
+        size_t lastSlash = filename.find_last_of('/');
+        if (lastSlash != std::string::npos) {
+            std::string dir = filename.substr(0, lastSlash);
+            if (!FileIO::createDirectories(dir)) {
+                std::cerr << "无法创建目录: " << dir << std::endl;
+                return false;
+            }
+        }
+
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "无法创建文件: " << filename << std::endl;
+            return false;
+        }
+
+        file << "文件,点数,三角形数,边数,计算耗时(纳秒)\n";
+        for (const FileStatistics& r : records()) {
+            file << r.name << "," << r.pointCount << "," << r.triangleCount << ","
+                << r.edgeCount << "," << r.duration << "\n";
+        }
+
+        file.close();
+        std::cout << "统计信息保存到: " << filename << std::endl;
+        return true;
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<FileStatistics> _records;
+};
+
+#endif
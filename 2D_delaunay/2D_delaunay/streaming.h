@@ -0,0 +1,531 @@
+#pragma once
+#ifndef H_STREAMING
+#define H_STREAMING
+
+#include "vector2.h"
+#include "circumcircle.h"
+#include "super_triangle.h"
+#include "predicates.h"
+#include "io.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+//流式剖分的统计信息
+struct StreamingStats
+{
+    std::uint64_t points = 0;       //插入的点数（含重合点）
+    std::uint64_t triangles = 0;    //输出的三角形数
+    std::size_t peakFaces = 0;      //同时驻留内存的三角形数的峰值
+    std::size_t peakVertices = 0;   //同时驻留内存的顶点数的峰值
+};
+
+//流式（外存）Delaunay 三角剖分：点逐个到达，不保存整个点集，三角形一旦“终结”就立即输出并释放。
+//包围盒被划分成均匀网格，事先统计每个格子里有多少个点；一个格子的点全部到达后该格子终结，
+//外接圆只覆盖终结格子的三角形不会再被之后的任何点破坏，可以输出。一个顶点的三角形全部输出后顶点也被释放。
+//结果与一次性剖分完全相同，驻留内存只取决于“未终结”区域的大小：输入按 x 排序、按 Hilbert 曲线排序
+//或按块（tile）组织时只是一条窄带；输入顺序杂乱时仍然正确，但内存会退化到整个剖分
+template <class T>
+class StreamingDelaunay
+{
+public:
+    using VertexType = Vector2<T>;
+
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    //超级三角形的三个顶点使用 SUPER_INDEX + 0..2，与 Delaunay 相同，是无穷远处的符号点
+    static constexpr std::uint32_t SUPER_INDEX = SuperTriangle::SUPER_INDEX;
+
+    //第一步：给出全部点的包围盒，终结网格大约分成 cellCount 个正方形格子
+    void begin(T minX, T minY, T maxX, T maxY, std::size_t cellCount)
+    {
+        const double cells = std::max<double>(1.0, double(cellCount));
+        const double w = std::max<double>(double(maxX) - double(minX), std::numeric_limits<double>::min());
+        const double h = std::max<double>(double(maxY) - double(minY), std::numeric_limits<double>::min());
+        const double cellSize = std::max(std::sqrt(w * h / cells), std::max(w, h) / cells);
+        _minX = minX;
+        _minY = minY;
+        _invCell = 1.0 / cellSize;
+        _cols = std::min<std::size_t>(static_cast<std::size_t>(w / cellSize) + 1, 1u << 15);
+        _rows = std::min<std::size_t>(static_cast<std::size_t>(h / cellSize) + 1, 1u << 15);
+        _remaining.assign(_cols * _rows, 0);
+        _hint.assign(_cols * _rows, INVALID_INDEX);
+
+        _faces.clear();
+        _circles.clear();
+        _blocked.clear();
+        _freeFaces.clear();
+        _vertices.clear();
+        _refs.clear();
+        _freeVertices.clear();
+        _fanStart.assign(3, INVALID_INDEX);
+        //超级三角形与 Delaunay 相同（无穷远处的符号点），同一组点得到同样的剖分
+        allocFace(makeFace(SUPER_INDEX, SUPER_INDEX + 1, SUPER_INDEX + 2));
+        _lastFace = 0;
+        _insertedSinceSweep = 0;
+        _finalizedSinceSweep = 0;
+        _stats = StreamingStats();
+    }
+
+    //第二步：登记一个将要插入的点，统计每个格子的点数。所有点都必须先登记再插入
+    void count(const VertexType& p)
+    {
+        ++_remaining[cellOf(p)];
+    }
+
+    //第三步：插入一个已登记的点（顺序可以与登记时不同），终结的三角形以逆时针顶点 emit(a, b, c) 输出
+    template <class Emit>
+    void insert(const VertexType& p, Emit&& emit)
+    {
+        const std::size_t cell = cellOf(p);
+        ++_stats.points;
+        insertVertex(p, cell);
+
+        if (_remaining[cell] > 0 && --_remaining[cell] == 0) ++_finalizedSinceSweep;
+        ++_insertedSinceSweep;
+        _stats.peakFaces = std::max(_stats.peakFaces, liveFaces());
+        _stats.peakVertices = std::max(_stats.peakVertices, liveVertices());
+
+        //有格子终结、且新插入的点数与驻留的三角形数相当时才扫描一遍，均摊后每个点仍为常数代价
+        if (_finalizedSinceSweep > 0 && _insertedSinceSweep >= std::max<std::size_t>(4096, liveFaces() / 4))
+            sweep(emit);
+    }
+
+    //全部点插入后输出剩余的三角形（不含超级三角形顶点），并释放内存
+    template <class Emit>
+    void finish(Emit&& emit)
+    {
+        for (const auto& f : _faces)
+        {
+            if (f.isBad || f.v[0] >= SUPER_INDEX || f.v[1] >= SUPER_INDEX || f.v[2] >= SUPER_INDEX) continue;
+            emit(point(f.v[0]), point(f.v[1]), point(f.v[2]));
+            ++_stats.triangles;
+        }
+        std::vector<Face>().swap(_faces);
+        _circles = CircumCircleBlock();
+        std::vector<std::uint32_t>().swap(_blocked);
+        std::vector<std::uint32_t>().swap(_freeFaces);
+        std::vector<VertexType>().swap(_vertices);
+        std::vector<std::uint32_t>().swap(_refs);
+        std::vector<std::uint32_t>().swap(_freeVertices);
+        std::vector<std::uint32_t>().swap(_fanStart);
+        std::vector<std::uint32_t>().swap(_remaining);
+        std::vector<std::uint32_t>().swap(_hint);
+    }
+
+    const StreamingStats& stats() const { return _stats; }
+    std::size_t liveFaces() const { return _faces.size() - _freeFaces.size(); }
+    std::size_t liveVertices() const { return _vertices.size() - _freeVertices.size(); }
+
+    //对文本点文件（每行 "x y"）做流式剖分：第一遍读包围盒，第二遍统计格子点数，第三遍插入。
+    //结果按 FileIO::saveTrianglesToFile 的格式（每行 "x1 y1 x2 y2 x3 y3"）写入 output。
+    //cellCount 为 0 时按平均每格约 64 个点选取
+    static bool triangulateFile(const std::string& input, const std::string& output,
+        StreamingStats* stats = nullptr, std::size_t cellCount = 0)
+    {
+        T minX = 0, minY = 0, maxX = 0, maxY = 0;
+        std::uint64_t n = 0;
+        FileIO::forEachPoint(input, [&](const Vector2<float>& p) {
+            if (n == 0)
+            {
+                minX = maxX = T(p.x);
+                minY = maxY = T(p.y);
+            }
+            minX = std::min(minX, T(p.x));
+            minY = std::min(minY, T(p.y));
+            maxX = std::max(maxX, T(p.x));
+            maxY = std::max(maxY, T(p.y));
+            ++n;
+        });
+        if (n == 0)
+        {
+            std::cerr << "文件没有数据或读取失败: " << input << std::endl;
+            return false;
+        }
+        if (cellCount == 0) cellCount = static_cast<std::size_t>(n / 64 + 1);
+
+        std::ofstream file(output);
+        if (!file.is_open())
+        {
+            std::cerr << "无法创建文件: " << output << std::endl;
+            return false;
+        }
+
+        StreamingDelaunay triangulation;
+        triangulation.begin(minX, minY, maxX, maxY, cellCount);
+        FileIO::forEachPoint(input, [&](const Vector2<float>& p) { triangulation.count(VertexType(T(p.x), T(p.y))); });
+
+        auto emit = [&file](const VertexType& a, const VertexType& b, const VertexType& c) {
+            file << a.x << " " << a.y << " " << b.x << " " << b.y << " " << c.x << " " << c.y << "\n";
+        };
+        FileIO::forEachPoint(input, [&](const Vector2<float>& p) { triangulation.insert(VertexType(T(p.x), T(p.y)), emit); });
+        triangulation.finish(emit);
+        if (stats) *stats = triangulation.stats();
+
+        file.close();
+        std::cout << "流式剖分: " << triangulation.stats().points << " 个点, 输出 " << triangulation.stats().triangles
+            << " 个三角形, 驻留三角形峰值 " << triangulation.stats().peakFaces << std::endl;
+        return bool(file);
+    }
+
+private:
+    //以顶点槽位表示的三角形（逆时针），n[i] 为边 (v[i], v[i+1]) 外侧的相邻三角形；
+    //外侧的三角形已经输出时同样记为 INVALID_INDEX
+    struct Face
+    {
+        std::uint32_t v[3];
+        std::uint32_t n[3];
+        bool isBad;
+    };
+
+    //空腔边界上的一条边，outer 为边外侧仍然保留的三角形
+    struct BoundaryEdge
+    {
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t outer;
+    };
+
+    static Face makeFace(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+    {
+        Face f;
+        f.v[0] = a; f.v[1] = b; f.v[2] = c;
+        f.n[0] = f.n[1] = f.n[2] = INVALID_INDEX;
+        f.isBad = false;
+        return f;
+    }
+
+    //按编号取真实顶点，超级三角形顶点没有坐标
+    const VertexType& point(std::uint32_t i) const
+    {
+        return _vertices[i];
+    }
+
+    //_fanStart 中的位置：真实顶点按槽位，超级三角形顶点排在最后
+    std::size_t fanSlot(std::uint32_t v) const
+    {
+        return v < SUPER_INDEX ? v : _vertices.size() + (v - SUPER_INDEX);
+    }
+
+    std::size_t cellCoord(double v, double origin, std::size_t size) const
+    {
+        const double c = (v - origin) * _invCell;
+        return c <= 0 ? 0 : std::min(static_cast<std::size_t>(c), size - 1);
+    }
+
+    std::size_t cellOf(const VertexType& p) const
+    {
+        return cellCoord(p.x, _minX, _cols) + cellCoord(p.y, _minY, _rows) * _cols;
+    }
+
+    //判断 p 是否在第 fi 个三角形的外接圆内（包括圆上），先用缓存的外接圆，靠近圆周时调用精确谓词
+    bool circumCircleContains(std::uint32_t fi, const VertexType& p) const
+    {
+        const int side = _circles.classify(fi, p.x, p.y);
+        if (side != 0) return side > 0;
+        const Face& f = _faces[fi];
+        return SuperTriangle::inCircle(_vertices, f.v[0], f.v[1], f.v[2], p) >= 0;
+    }
+
+    //取一个空闲槽位（没有时追加）存放新三角形，并缓存其外接圆
+    std::uint32_t allocFace(const Face& f)
+    {
+        std::uint32_t fi;
+        if (!_freeFaces.empty())
+        {
+            fi = _freeFaces.back();
+            _freeFaces.pop_back();
+        }
+        else
+        {
+            fi = static_cast<std::uint32_t>(_faces.size());
+            _faces.push_back(f);
+            _circles.resize(_faces.size());
+            _blocked.push_back(INVALID_INDEX);
+        }
+        _faces[fi] = f;
+        _blocked[fi] = INVALID_INDEX;
+        for (int e = 0; e < 3; ++e)
+        {
+            if (f.v[e] < SUPER_INDEX) ++_refs[f.v[e]];
+        }
+
+        if (f.v[0] < SUPER_INDEX && f.v[1] < SUPER_INDEX && f.v[2] < SUPER_INDEX)
+        {
+            const VertexType& a = point(f.v[0]);
+            const VertexType& b = point(f.v[1]);
+            const VertexType& c = point(f.v[2]);
+            _circles.set(fi, a.x, a.y, b.x, b.y, c.x, c.y);
+        }
+        else
+        {
+            _circles.setUnbounded(fi);
+        }
+        return fi;
+    }
+
+    //取一个空闲的顶点槽位存放 p
+    std::uint32_t allocVertex(const VertexType& p)
+    {
+        std::uint32_t vi;
+        if (!_freeVertices.empty())
+        {
+            vi = _freeVertices.back();
+            _freeVertices.pop_back();
+            _vertices[vi] = p;
+        }
+        else
+        {
+            vi = static_cast<std::uint32_t>(_vertices.size());
+            _vertices.push_back(p);
+            _refs.push_back(0);
+        }
+        _refs[vi] = 0;
+        _fanStart.resize(_vertices.size() + 3, INVALID_INDEX);
+        return vi;
+    }
+
+    //从格子记录的三角形出发沿邻接关系向 p 行走。已经输出的区域不在结构中，行走可能被它挡住，
+    //此时退回到扫描全部驻留的三角形，找一个外接圆包含 p 的作为空腔的种子
+    std::uint32_t locate(const VertexType& p, std::size_t cell)
+    {
+        std::uint32_t f = _hint[cell];
+        if (f == INVALID_INDEX || _faces[f].isBad) f = _lastFace;
+        if (!_faces[f].isBad)
+        {
+            for (std::size_t step = 0; step < _faces.size(); ++step)
+            {
+                const Face& face = _faces[f];
+                _seed = _seed * 1103515245u + 12345u;
+                const int r = static_cast<int>((_seed >> 16) % 3);
+
+                //p 在外侧、但外侧三角形已经输出的边跳过，换一条边继续走
+                std::uint32_t next = INVALID_INDEX;
+                bool inside = true;
+                for (int k = 0; k < 3 && next == INVALID_INDEX; ++k)
+                {
+                    const int e = (r + k) % 3;
+                    if (SuperTriangle::orient(_vertices, face.v[e], face.v[(e + 1) % 3], p) < 0)
+                    {
+                        inside = false;
+                        next = face.n[e];
+                    }
+                }
+                if (inside) return f;
+                if (next == INVALID_INDEX) break;
+                f = next;
+            }
+        }
+
+        std::uint8_t inside[256];
+        for (std::size_t first = 0; first < _faces.size(); first += 256)
+        {
+            const std::size_t count = std::min<std::size_t>(256, _faces.size() - first);
+            _circles.containsBatch(p.x, p.y, first, count, inside);
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                const std::uint32_t i = static_cast<std::uint32_t>(first + k);
+                if (inside[k] && !_faces[i].isBad && circumCircleContains(i, p)) return i;
+            }
+        }
+        return INVALID_INDEX;
+    }
+
+    //Bowyer-Watson 插入，与 Delaunay::insertVertex 相同；空腔的三角形槽位直接给新三角形复用。
+    //p 与已有顶点重合时不插入
+    void insertVertex(const VertexType& p, std::size_t cell)
+    {
+        const std::uint32_t start = locate(p, cell);
+        if (start == INVALID_INDEX) return;
+
+        //重合的点：它所在的三角形都在圆上，一定会进入空腔，扩散时顺便检查
+        _cavity.clear();
+        _faces[start].isBad = true;
+        _cavity.push_back(start);
+        bool duplicate = false;
+        for (std::size_t k = 0; k < _cavity.size() && !duplicate; ++k)
+        {
+            const Face& f = _faces[_cavity[k]];
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.v[e] < SUPER_INDEX && point(f.v[e]) == p) duplicate = true;
+                const std::uint32_t ni = f.n[e];
+                if (ni != INVALID_INDEX && !_faces[ni].isBad && circumCircleContains(ni, p))
+                {
+                    _faces[ni].isBad = true;
+                    _cavity.push_back(ni);
+                }
+            }
+        }
+        if (duplicate)
+        {
+            for (const std::uint32_t fi : _cavity) _faces[fi].isBad = false;
+            return;
+        }
+
+        _polygon.clear();
+        for (const std::uint32_t fi : _cavity)
+        {
+            const Face& f = _faces[fi];
+            for (int e = 0; e < 3; ++e)
+            {
+                if (f.n[e] == INVALID_INDEX || !_faces[f.n[e]].isBad)
+                    _polygon.push_back(BoundaryEdge{ f.v[e], f.v[(e + 1) % 3], f.n[e] });
+            }
+        }
+
+        //空腔的顶点都在边界上，都会连到新三角形，这里只减引用计数、不释放
+        for (const std::uint32_t fi : _cavity)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                if (_faces[fi].v[e] < SUPER_INDEX) --_refs[_faces[fi].v[e]];
+            }
+            _freeFaces.push_back(fi);
+        }
+
+        const std::uint32_t vi = allocVertex(p);
+        _created.clear();
+        for (const auto& be : _polygon)
+        {
+            Face f = makeFace(be.a, be.b, vi);
+            f.n[0] = be.outer;
+            const std::uint32_t fi = allocFace(f);
+            _created.push_back(fi);
+            if (be.outer != INVALID_INDEX)
+            {
+                Face& o = _faces[be.outer];
+                for (int e = 0; e < 3; ++e)
+                {
+                    if (o.v[e] == be.b && o.v[(e + 1) % 3] == be.a) o.n[e] = fi;
+                }
+            }
+        }
+
+        //以边界起点编号登记新三角形，线性时间内连接相邻的新三角形
+        for (const std::uint32_t fi : _created)
+        {
+            _fanStart[fanSlot(_faces[fi].v[0])] = fi;
+        }
+        for (const std::uint32_t fi : _created)
+        {
+            const std::uint32_t j = _fanStart[fanSlot(_faces[fi].v[1])];
+            _faces[fi].n[1] = j;
+            _faces[j].n[2] = fi;
+        }
+
+        _lastFace = _created[0];
+        _hint[cell] = _created[0];
+    }
+
+    //外接圆（加上误差界）覆盖的格子中第一个还没有终结的格子，全部终结时返回 INVALID_INDEX
+    std::uint32_t firstOpenCell(const Face& f) const
+    {
+        const VertexType& a = point(f.v[0]);
+        const VertexType& b = point(f.v[1]);
+        const VertexType& c = point(f.v[2]);
+        double x, y, r2, err;
+        computeCircumCircle(a.x, a.y, b.x, b.y, c.x, c.y, x, y, r2, err);
+        if (!(r2 < std::numeric_limits<double>::infinity())) return static_cast<std::uint32_t>(cellOf(a));
+
+        //半径与圆心的舍入误差同阶，两者都按 err 放大，再留出相对误差的余量
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double r = std::sqrt(r2);
+        const double reach = r + 2 * err + 8 * eps * (r + std::abs(x) + std::abs(y));
+        const std::size_t col0 = cellCoord(x - reach, _minX, _cols), col1 = cellCoord(x + reach, _minX, _cols);
+        const std::size_t row0 = cellCoord(y - reach, _minY, _rows), row1 = cellCoord(y + reach, _minY, _rows);
+        for (std::size_t row = row0; row <= row1; ++row)
+        {
+            for (std::size_t col = col0; col <= col1; ++col)
+            {
+                if (_remaining[row * _cols + col] > 0) return static_cast<std::uint32_t>(row * _cols + col);
+            }
+        }
+        return INVALID_INDEX;
+    }
+
+    //输出一个终结的三角形并释放它，只剩它引用的顶点一并释放
+    void evict(std::uint32_t fi)
+    {
+        Face& f = _faces[fi];
+        for (int e = 0; e < 3; ++e)
+        {
+            const std::uint32_t ni = f.n[e];
+            if (ni == INVALID_INDEX) continue;
+            for (int k = 0; k < 3; ++k)
+            {
+                if (_faces[ni].n[k] == fi) _faces[ni].n[k] = INVALID_INDEX;
+            }
+        }
+        for (int e = 0; e < 3; ++e)
+        {
+            if (--_refs[f.v[e]] == 0) _freeVertices.push_back(f.v[e]);
+        }
+        f.isBad = true;
+        _freeFaces.push_back(fi);
+    }
+
+    //检查所有驻留的三角形，输出已经终结的。上次挡住它的格子仍未终结时直接跳过
+    template <class Emit>
+    void sweep(Emit& emit)
+    {
+        for (std::uint32_t fi = 0; fi < _faces.size(); ++fi)
+        {
+            const Face& f = _faces[fi];
+            if (f.isBad || f.v[0] >= SUPER_INDEX || f.v[1] >= SUPER_INDEX || f.v[2] >= SUPER_INDEX) continue;
+            if (_blocked[fi] != INVALID_INDEX && _remaining[_blocked[fi]] > 0) continue;
+
+            _blocked[fi] = firstOpenCell(f);
+            if (_blocked[fi] != INVALID_INDEX) continue;
+
+            emit(point(f.v[0]), point(f.v[1]), point(f.v[2]));
+            ++_stats.triangles;
+            evict(fi);
+        }
+        if (_faces[_lastFace].isBad)
+        {
+            for (std::uint32_t fi = 0; fi < _faces.size(); ++fi)
+            {
+                if (!_faces[fi].isBad) _lastFace = fi;
+            }
+        }
+        _insertedSinceSweep = 0;
+        _finalizedSinceSweep = 0;
+    }
+
+    std::vector<Face> _faces;
+    CircumCircleBlock _circles;
+    std::vector<std::uint32_t> _blocked;
+    std::vector<std::uint32_t> _freeFaces;
+    std::vector<VertexType> _vertices;
+    std::vector<std::uint32_t> _refs;
+    std::vector<std::uint32_t> _freeVertices;
+    std::vector<std::uint32_t> _fanStart;
+    std::vector<std::uint32_t> _cavity;
+    std::vector<BoundaryEdge> _polygon;
+    std::vector<std::uint32_t> _created;
+    std::uint32_t _lastFace = 0;
+    std::uint32_t _seed = 1;
+
+    //终结网格：每格剩余未到达的点数，以及最近在格子中产生的三角形（行走的起点）
+    std::vector<std::uint32_t> _remaining;
+    std::vector<std::uint32_t> _hint;
+    std::size_t _cols = 1;
+    std::size_t _rows = 1;
+    double _minX = 0;
+    double _minY = 0;
+    double _invCell = 1;
+    std::size_t _insertedSinceSweep = 0;
+    std::size_t _finalizedSinceSweep = 0;
+
+    StreamingStats _stats;
+};
+
+#endif
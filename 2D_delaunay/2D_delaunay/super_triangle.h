@@ -0,0 +1,174 @@
+#pragma once
+#ifndef H_SUPER_TRIANGLE
+#define H_SUPER_TRIANGLE
+
+#include "predicates.h"
+
+#include <cstdint>
+#include <cmath>
+#include <utility>
+#include <type_traits>
+
+//符号化的超级三角形。三个顶点不取具体坐标，而是看作随 M 趋于无穷远的点
+//  s0 = (-M^2, -M)，s1 = (M^2, -M)，s2 = (M, M^3)（逆时针），
+//任何有限的点都严格在它内部。含超级顶点的 orient / incircle 取 M 充分大时行列式的符号，
+//只需比较坐标并调用精确的 orient2d，结果与一组真实存在的点一致，逐点插入和删除点的算法都不受影响。
+//有限大小的超级三角形会挤掉凸包附近的 Delaunay 三角形，顶点在无穷远处时不会，
+//去掉含超级顶点的三角形后剩下的正好是输入点的 Delaunay 剖分，边界就是凸包。
+//顶点编号不小于 SUPER_INDEX 的是超级顶点 SUPER_INDEX + 0..2，其余编号用 points[i] 取坐标，
+//points 可以是 Vector2 数组，也可以是按值返回点的 PointView
+struct SuperTriangle
+{
+    static constexpr std::uint32_t SUPER_INDEX = 0xFFFFFFFCu;
+
+    static bool isSuper(std::uint32_t v) { return v >= SUPER_INDEX; }
+
+    //(a, b, c) 的方向：1 为逆时针，-1 为顺时针，0 为共线
+    template <class Points>
+    static int orient(const Points& points, std::uint32_t a, std::uint32_t b, std::uint32_t c)
+    {
+        //轮换不改变方向，尽量把真实的点放到最后
+        if (isSuper(c))
+        {
+            if (!isSuper(a)) return orient(points, b, c, points[a]);
+            if (!isSuper(b)) return orient(points, c, a, points[b]);
+            return superPair(a, b);
+        }
+        return orient(points, a, b, points[c]);
+    }
+
+    //(a, b, p) 的方向，p 是任意一个有限的点
+    template <class Points, class P>
+    static int orient(const Points& points, std::uint32_t a, std::uint32_t b, const P& p)
+    {
+        if (!isSuper(a) && !isSuper(b)) return sign(predicates::orient2d(points[a].x, points[a].y, points[b].x, points[b].y, p.x, p.y));
+        if (isSuper(a) && isSuper(b)) return superPair(a, b);
+        return isSuper(a) ? superOrient(a, points[b], p) : superOrient(b, p, points[a]);
+    }
+
+    //p 与逆时针三角形 (a, b, c) 外接圆的位置：1 为圆内，0 为圆上，-1 为圆外
+    template <class Points, class P>
+    static int inCircle(const Points& points, std::uint32_t a, std::uint32_t b, std::uint32_t c, const P& p)
+    {
+        if (!isSuper(a) && !isSuper(b) && !isSuper(c))
+        {
+            const P pa = points[a];
+            const P pb = points[b];
+            const P pc = points[c];
+            return sign(predicates::incircle(pa.x, pa.y, pb.x, pb.y, pc.x, pc.y, p.x, p.y));
+        }
+        std::uint32_t v[4] = { a, b, c, 0 };
+        P q[4];
+        q[3] = p;
+        for (int k = 0; k < 3; ++k)
+        {
+            if (!isSuper(v[k])) q[k] = points[v[k]];
+        }
+        return inCircle(v, q);
+    }
+
+    //第 d 个点与逆时针三角形 (a, b, c) 外接圆的位置，d 也可以是超级顶点
+    template <class Points>
+    static int inCircle(const Points& points, std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d)
+    {
+        if (!isSuper(d)) return inCircle(points, a, b, c, points[d]);
+        using P = typename std::decay<decltype(points[0])>::type;
+        std::uint32_t v[4] = { a, b, c, d };
+        P q[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            if (!isSuper(v[k])) q[k] = points[v[k]];
+        }
+        return inCircle(v, q);
+    }
+
+private:
+    //v 为四个顶点的编号，q 为其中真实点的坐标（超级顶点对应的项不使用）
+    template <class P>
+    static int inCircle(std::uint32_t v[4], P q[4])
+    {
+        //把真实的点稳定地移到超级顶点之前，每交换一次行列式变号
+        int parity = 1;
+        for (int pass = 0; pass < 3; ++pass)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                if (isSuper(v[k]) && !isSuper(v[k + 1]))
+                {
+                    std::swap(v[k], v[k + 1]);
+                    std::swap(q[k], q[k + 1]);
+                    parity = -parity;
+                }
+            }
+        }
+        const int supers = int(isSuper(v[1])) + int(isSuper(v[2])) + int(isSuper(v[3]));
+        const std::uint32_t* s = v + 4 - supers;
+
+        switch (supers)
+        {
+        case 0:
+            return sign(predicates::incircle(q[0].x, q[0].y, q[1].x, q[1].y, q[2].x, q[2].y, q[3].x, q[3].y));
+        case 1:
+        {
+            //(a, b, c, s)：s 在无穷远处，圆退化为过 a、b 的直线一侧的半平面
+            const int side = superOrient(s[0], q[0], q[1]);
+            const int o = sign(predicates::orient2d(q[0].x, q[0].y, q[1].x, q[1].y, q[2].x, q[2].y));
+            const int inside = o != 0 ? (o == side ? 1 : -1) : (between(q[2], q[0], q[1]) ? 1 : -1);
+            return -parity * side * inside;
+        }
+        case 2:
+            return parity * superPair(s[0], s[1]) * pairInside(s[0], s[1], q[0], q[1]);
+        default:
+            return -parity * superPair(s[0], s[1]);
+        }
+    }
+
+    template <class U>
+    static int compare(U a, U b) { return int(a > b) - int(a < b); }
+
+    static int sign(double v) { return int(v > 0) - int(v < 0); }
+
+    //两个超级顶点与一个有限点的方向：逆时针相邻（s0→s1→s2→s0）为 1
+    static int superPair(std::uint32_t i, std::uint32_t j)
+    {
+        return (i - SUPER_INDEX + 1) % 3 == j - SUPER_INDEX ? 1 : -1;
+    }
+
+    //(s, a, b) 的方向，s 为超级顶点：由 a - b 的主导分量决定
+    template <class P>
+    static int superOrient(std::uint32_t s, const P& a, const P& b)
+    {
+        const int dx = compare(a.x, b.x);
+        const int dy = compare(a.y, b.y);
+        switch (s - SUPER_INDEX)
+        {
+        case 0: return dy != 0 ? -dy : dx;
+        case 1: return dy != 0 ? dy : dx;
+        default: return dx != 0 ? -dx : dy;
+        }
+    }
+
+    //过 a 与超级顶点 si、sj 的“圆”是否包含 b
+    template <class P>
+    static int pairInside(std::uint32_t si, std::uint32_t sj, const P& a, const P& b)
+    {
+        const std::uint32_t pair = si + sj - 2 * SUPER_INDEX;
+        if (pair == 1)
+        {
+            if (b.y != a.y) return b.y < a.y ? 1 : -1;
+            return compare(std::abs(a.x), std::abs(b.x));
+        }
+        if (b.y != a.y) return b.y > a.y ? 1 : -1;
+        return pair == 3 ? compare(b.x, a.x) : compare(a.x, b.x);
+    }
+
+    //共线的三点中 c 是否严格在 a、b 之间
+    template <class P>
+    static bool between(const P& c, const P& a, const P& b)
+    {
+        return a.x != b.x ? (a.x < c.x) == (c.x < b.x) && c.x != a.x && c.x != b.x
+                          : (a.y < c.y) == (c.y < b.y) && c.y != a.y && c.y != b.y;
+    }
+};
+
+#endif
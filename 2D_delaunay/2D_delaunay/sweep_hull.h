@@ -0,0 +1,326 @@
+#pragma once
+#ifndef H_SWEEP_HULL
+#define H_SWEEP_HULL
+
+#include "vector2.h"
+#include "point_view.h"
+#include "circumcircle.h"
+#include "predicates.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+//扫描凸包（sweep-hull）剖分：从中心附近的种子三角形出发，其余点按到种子外接圆圆心的距离由近到远加入。
+//每个新点都在已有凸包之外，只需把它与凸包上可见的边连成三角形，再用 Lawson 翻转恢复空圆性质。
+//凸包保存为双向链表，按点相对圆心的伪角度建立哈希表，新点从哈希到的凸包顶点出发寻找可见边，
+//不需要点定位，也不需要超级三角形。剖分结果以半边数组表示，半边 e 属于三角形 e / 3。
+//orient / incircle 都使用精确谓词，四点共圆时不翻转，网格等退化输入也能正常结束
+template <class T>
+class SweepHull
+{
+public:
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    //每 3 个编号组成一个逆时针三角形，半边 e 从 triangles[e] 指向同一三角形中的下一个顶点
+    std::vector<std::uint32_t> triangles;
+
+    //halfedges[e] 为半边 e 的反向半边，凸包边为 INVALID_INDEX
+    std::vector<std::uint32_t> halfedges;
+
+    //剖分 points，完全重合的点只保留编号最小的一个。
+    //少于三个不重合的点或全部共线时返回 false；距离的舍入误差使某个点落在已有凸包之内时也返回 false，
+    //此时结果不完整，由调用方改用逐点插入
+    bool triangulate(const PointView<T>& points)
+    {
+        triangles.clear();
+        halfedges.clear();
+        const std::size_t n = points.size();
+        if (n < 3 || n >= INVALID_INDEX) return false;
+        const std::uint32_t count = static_cast<std::uint32_t>(n);
+
+        double minX = points.x(0), minY = points.y(0);
+        double maxX = minX, maxY = minY;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            minX = std::min<double>(minX, points.x(i));
+            minY = std::min<double>(minY, points.y(i));
+            maxX = std::max<double>(maxX, points.x(i));
+            maxY = std::max<double>(maxY, points.y(i));
+        }
+
+        //种子三角形：离包围盒中心最近的点、离它最近的点，以及与这两点构成的外接圆最小的点
+        std::uint32_t i0 = 0, i1 = INVALID_INDEX, i2 = INVALID_INDEX;
+        double best = std::numeric_limits<double>::infinity();
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const double d = distance2((minX + maxX) / 2, (minY + maxY) / 2, points.x(i), points.y(i));
+            if (d < best)
+            {
+                i0 = i;
+                best = d;
+            }
+        }
+        const double x0 = points.x(i0), y0 = points.y(i0);
+
+        best = std::numeric_limits<double>::infinity();
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const double d = distance2(x0, y0, points.x(i), points.y(i));
+            if (d > 0 && d < best)
+            {
+                i1 = i;
+                best = d;
+            }
+        }
+        if (i1 == INVALID_INDEX) return false;
+        const double x1 = points.x(i1), y1 = points.y(i1);
+
+        best = std::numeric_limits<double>::infinity();
+        double cx, cy, r2, err;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            if (i == i0 || i == i1) continue;
+            computeCircumCircle(x0, y0, x1, y1, points.x(i), points.y(i), cx, cy, r2, err);
+            if (r2 < best)
+            {
+                i2 = i;
+                best = r2;
+            }
+        }
+        if (i2 == INVALID_INDEX) return false;
+
+        const double o = predicates::orient2d(x0, y0, x1, y1, points.x(i2), points.y(i2));
+        if (o == 0) return false;
+        if (o < 0) std::swap(i1, i2);
+        computeCircumCircle(x0, y0, points.x(i1), points.y(i1), points.x(i2), points.y(i2), _cx, _cy, r2, err);
+
+        //按到圆心的距离排序；距离相同时按坐标、编号排序，重合的点排在一起且编号最小的在前
+        _dists.resize(count);
+        _ids.resize(count);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            _dists[i] = distance2(_cx, _cy, points.x(i), points.y(i));
+            _ids[i] = i;
+        }
+        std::sort(_ids.begin(), _ids.end(), [&](std::uint32_t a, std::uint32_t b) {
+            if (_dists[a] != _dists[b]) return _dists[a] < _dists[b];
+            if (points.x(a) != points.x(b)) return points.x(a) < points.x(b);
+            if (points.y(a) != points.y(b)) return points.y(a) < points.y(b);
+            return a < b;
+        });
+
+        //凸包为逆时针的双向链表，_hullTri[v] 为从 v 出发的凸包边对应的半边；被覆盖的顶点 _hullNext[v] == v
+        _hashSize = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(std::sqrt(double(count)))));
+        _hullHash.assign(_hashSize, INVALID_INDEX);
+        _hullPrev.resize(count);
+        _hullNext.resize(count);
+        _hullTri.resize(count);
+        _hullNext[i0] = _hullPrev[i2] = i1;
+        _hullNext[i1] = _hullPrev[i0] = i2;
+        _hullNext[i2] = _hullPrev[i1] = i0;
+        _hullHash[hashKey(x0, y0)] = i0;
+        _hullHash[hashKey(points.x(i1), points.y(i1))] = i1;
+        _hullHash[hashKey(points.x(i2), points.y(i2))] = i2;
+        std::uint32_t hullStart = i0;
+
+        //n 个点的剖分不超过 2n - 5 个三角形
+        triangles.reserve(3 * (2 * n));
+        halfedges.reserve(3 * (2 * n));
+        addTriangle(i0, i1, i2, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX);
+
+        double xp = 0, yp = 0;
+        for (std::uint32_t k = 0; k < count; ++k)
+        {
+            const std::uint32_t i = _ids[k];
+            const double x = points.x(i), y = points.y(i);
+
+            //与前一个点重合的点跳过，种子已经在剖分中
+            if (k > 0 && x == xp && y == yp) continue;
+            xp = x;
+            yp = y;
+            if (i == i0 || i == i1 || i == i2) continue;
+
+            //从哈希表中找一个仍在凸包上的顶点，沿凸包向前找到第一条可见边 (e, q)
+            std::uint32_t start = INVALID_INDEX;
+            const std::size_t key = hashKey(x, y);
+            for (std::size_t j = 0; j < _hashSize; ++j)
+            {
+                start = _hullHash[(key + j) % _hashSize];
+                if (start != INVALID_INDEX && start != _hullNext[start]) break;
+                start = INVALID_INDEX;
+            }
+            start = start == INVALID_INDEX ? hullStart : _hullPrev[start];
+
+            std::uint32_t e = start;
+            std::uint32_t q = _hullNext[e];
+            while (!visible(points, e, q, x, y))
+            {
+                e = q;
+                if (e == start) return false;
+                q = _hullNext[e];
+            }
+
+            //新点与第一条可见边构成三角形，再向前、向后连接其余可见边
+            std::uint32_t t = addTriangle(e, i, q, INVALID_INDEX, INVALID_INDEX, _hullTri[e]);
+            legalize(points, t + 2);
+
+            std::uint32_t next = q;
+            for (q = _hullNext[next]; visible(points, next, q, x, y); q = _hullNext[next])
+            {
+                t = addTriangle(next, i, q, _hullTri[i], INVALID_INDEX, _hullTri[next]);
+                legalize(points, t + 2);
+                _hullNext[next] = next;
+                next = q;
+            }
+
+            if (e == start)
+            {
+                for (q = _hullPrev[e]; visible(points, q, e, x, y); q = _hullPrev[e])
+                {
+                    t = addTriangle(q, i, e, INVALID_INDEX, _hullTri[e], _hullTri[q]);
+                    legalize(points, t + 2);
+                    _hullNext[e] = e;
+                    e = q;
+                }
+            }
+
+            hullStart = _hullPrev[i] = e;
+            _hullNext[e] = _hullPrev[next] = i;
+            _hullNext[i] = next;
+            _hullHash[hashKey(x, y)] = i;
+            _hullHash[hashKey(points.x(e), points.y(e))] = e;
+        }
+        return true;
+    }
+
+    //清空结果，保留缓冲区的容量
+    void clear()
+    {
+        triangles.clear();
+        halfedges.clear();
+        _stack.clear();
+    }
+
+    //按不超过 n 个点预先分配
+    void reserve(std::size_t n)
+    {
+        triangles.reserve(6 * n);
+        halfedges.reserve(6 * n);
+        _dists.reserve(n);
+        _ids.reserve(n);
+        _hullPrev.reserve(n);
+        _hullNext.reserve(n);
+        _hullTri.reserve(n);
+        _hullHash.reserve(static_cast<std::size_t>(std::ceil(std::sqrt(double(n)))) + 1);
+        _stack.reserve(64);
+    }
+
+private:
+    static double distance2(double ax, double ay, double bx, double by)
+    {
+        const double dx = ax - bx;
+        const double dy = ay - by;
+        return dx * dx + dy * dy;
+    }
+
+    //(dx, dy) 的伪角度，取值 [0, 1)，随真实角度单调递增，不需要调用 atan2
+    static double pseudoAngle(double dx, double dy)
+    {
+        const double p = dx / (std::abs(dx) + std::abs(dy));
+        return (dy > 0 ? 3 - p : 1 + p) / 4;
+    }
+
+    std::size_t hashKey(double x, double y) const
+    {
+        const double a = pseudoAngle(x - _cx, y - _cy);
+        if (!(a >= 0)) return 0;
+        return static_cast<std::size_t>(a * _hashSize) % _hashSize;
+    }
+
+    //凸包边 (a, b) 对点 (x, y) 是否可见：点严格在边的右侧（凸包之外）
+    static bool visible(const PointView<T>& points, std::uint32_t a, std::uint32_t b, double x, double y)
+    {
+        return predicates::orient2d(points.x(a), points.y(a), points.x(b), points.y(b), x, y) < 0;
+    }
+
+    //连接半边 a 与 b；b 为 INVALID_INDEX 时 a 是凸包边，记到它的起点上
+    void link(std::uint32_t a, std::uint32_t b)
+    {
+        halfedges[a] = b;
+        if (b != INVALID_INDEX) halfedges[b] = a;
+        else _hullTri[triangles[a]] = a;
+    }
+
+    //添加逆时针三角形 (a, b, c)，ab、bc、ca 三条边分别与半边 hab、hbc、hca 相对，返回第一条半边的编号
+    std::uint32_t addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c,
+        std::uint32_t hab, std::uint32_t hbc, std::uint32_t hca)
+    {
+        const std::uint32_t t = static_cast<std::uint32_t>(triangles.size());
+        triangles.push_back(a);
+        triangles.push_back(b);
+        triangles.push_back(c);
+        halfedges.resize(t + 3);
+        link(t, hab);
+        link(t + 1, hbc);
+        link(t + 2, hca);
+        return t;
+    }
+
+    //从新点对面的半边 a 开始做 Lawson 翻转：a 所在三角形为 (pr, pl, p0)，p0 是新点，
+    //相邻三角形的对顶点 p1 落在其外接圆内时把对角线 pr-pl 换成 p0-p1，再检查 p0 对面的两条新边
+    void legalize(const PointView<T>& points, std::uint32_t a)
+    {
+        _stack.clear();
+        _stack.push_back(a);
+        while (!_stack.empty())
+        {
+            a = _stack.back();
+            _stack.pop_back();
+            const std::uint32_t b = halfedges[a];
+            if (b == INVALID_INDEX) continue;
+
+            const std::uint32_t a0 = a - a % 3;
+            const std::uint32_t b0 = b - b % 3;
+            const std::uint32_t al = a0 + (a + 1) % 3;
+            const std::uint32_t ar = a0 + (a + 2) % 3;
+            const std::uint32_t br = b0 + (b + 1) % 3;
+            const std::uint32_t bl = b0 + (b + 2) % 3;
+
+            const std::uint32_t pr = triangles[a];
+            const std::uint32_t pl = triangles[al];
+            const std::uint32_t p0 = triangles[ar];
+            const std::uint32_t p1 = triangles[bl];
+            if (predicates::incircle(points.x(pr), points.y(pr), points.x(pl), points.y(pl),
+                points.x(p0), points.y(p0), points.x(p1), points.y(p1)) <= 0)
+                continue;
+
+            //翻转后两个三角形为 (p1, pl, p0) 与 (p0, pr, p1)
+            triangles[a] = p1;
+            triangles[b] = p0;
+            const std::uint32_t hbl = halfedges[bl];
+            const std::uint32_t har = halfedges[ar];
+            link(a, hbl);
+            link(b, har);
+            link(ar, bl);
+            _stack.push_back(a);
+            _stack.push_back(br);
+        }
+    }
+
+    double _cx = 0;
+    double _cy = 0;
+    std::size_t _hashSize = 1;
+    std::vector<double> _dists;
+    std::vector<std::uint32_t> _ids;
+    std::vector<std::uint32_t> _hullPrev;
+    std::vector<std::uint32_t> _hullNext;
+    std::vector<std::uint32_t> _hullTri;
+    std::vector<std::uint32_t> _hullHash;
+    std::vector<std::uint32_t> _stack;
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include "vector2.h"
 #include "edge.h"
 #include "numeric.h"
+#include "circumcircle.h"
+#include "predicates.h"
 
 template <class T>
 class Triangle
@@ -13,34 +15,48 @@ public:
 	using EdgeType = Edge<T>;
 	using VertexType = Vector2<T>;
 
-	//캯
+	//构造函数
 	Triangle(const VertexType& _p1, const VertexType& _p2, const VertexType& _p3)
 		: p1(_p1), p2(_p2), p3(_p3),
 		e1(_p1, _p2), e2(_p2, _p3), e3(_p3, _p1), isBad(false)
 	{
+		//构造时计算一次外接圆及其误差界，之后大多数判断只需一次距离比较
+		double x, y, r2, err;
+		computeCircumCircle(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, x, y, r2, err);
+
+		circumCenter = VertexType(static_cast<T>(x), static_cast<T>(y));
+		circumRadius2 = static_cast<T>(r2);
+		//转换到 T 精度时圆心再多出一次舍入，判断也在 T 精度下进行
+		const double eps = std::numeric_limits<T>::epsilon();
+		double tolA, tolB;
+		computeCircumTolerance(r2, err + 2 * eps * (std::abs(x) + std::abs(y)), eps, tolA, tolB);
+		circumTolA = static_cast<T>(tolA);
+		circumTolB = static_cast<T>(tolB);
 	}
 
-	//жһǷڲ
+	//判断一点是否在三角形内部
 	bool containsVertex(const VertexType& v) const
 	{
 		// return p1 == v || p2 == v || p3 == v;
 		return almost_equal(p1, v) || almost_equal(p2, v) || almost_equal(p3, v);
 	}
 
-	//жһǷԲڣԲϣ
+	//判断一点是否在外接圆内（包括在外接圆上）。
+	//缓存的外接圆无法确定时（点接近圆周，或三点共线）改用精确谓词
 	bool circumCircleContains(const VertexType& v) const
 	{
-		const T ab = p1.norm2();
-		const T cd = p2.norm2();
-		const T ef = p3.norm2();
-
-		const T circum_x = (ab * (p3.y - p2.y) + cd * (p1.y - p3.y) + ef * (p2.y - p1.y)) / (p1.x * (p3.y - p2.y) + p2.x * (p1.y - p3.y) + p3.x * (p2.y - p1.y));
-		const T circum_y = (ab * (p3.x - p2.x) + cd * (p1.x - p3.x) + ef * (p2.x - p1.x)) / (p1.y * (p3.x - p2.x) + p2.y * (p1.x - p3.x) + p3.y * (p2.x - p1.x));
+		const int side = classifyCircumCircle(circumCenter.x, circumCenter.y, circumRadius2, circumTolA, circumTolB, v.x, v.y);
+		if (side != 0) return side > 0;
+		return exactCircumCircleContains(v);
+	}
 
-		const VertexType circum(half(circum_x), half(circum_y));
-		const T circum_radius = p1.dist2(circum);
-		const T dist = v.dist2(circum);
-		return dist <= circum_radius;
+	//用精确谓词判断，共线的三角形没有外接圆，返回 false
+	bool exactCircumCircleContains(const VertexType& v) const
+	{
+		const double o = predicates::orient2d(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y);
+		if (o == 0) return false;
+		const double d = predicates::incircle(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, v.x, v.y);
+		return o > 0 ? d >= 0 : d <= 0;
 	}
 
 	VertexType p1;
@@ -49,6 +65,10 @@ public:
 	EdgeType e1;
 	EdgeType e2;
 	EdgeType e3;
+	VertexType circumCenter;
+	T circumRadius2;
+	T circumTolA;
+	T circumTolB;
 	bool isBad;
 };
 
@@ -67,7 +87,7 @@ inline bool operator == (const Triangle<T>& t1, const Triangle<T>& t2)
 		(t1.p3 == t2.p1 || t1.p3 == t2.p2 || t1.p3 == t2.p3);
 }
 
-//ע almost ú numeric.h ж
+//注意这里的 almost 函数，该函数在 numeric.h 中定义
 template <class T>
 inline bool almost_equal(const Triangle<T>& t1, const Triangle<T>& t2)
 {
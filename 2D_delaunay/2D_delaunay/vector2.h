@@ -12,13 +12,13 @@ class Vector2
 {
 public:
 
-	// Constructors  캯
+	// Constructors  构造函数
 	Vector2() :x(0), y(0) {}
 	Vector2(T _x, T _y) : x(_x), y(_y) {}
-	Vector2(const Vector2& v) : x(v.x), y(v.y) {}
+	Vector2(const Vector2& v) = default;
 
 	// Operations  
-	// 
+	// 计算距离
 	T dist2(const Vector2& v) const
 	{
 		T dx = x - v.x;
@@ -31,7 +31,7 @@ public:
 		return sqrt(dist2(v));
 	}
 
-	//ƽͣ˺ delaunay.h жһǷڲ
+	//计算平方和，此函数在 delaunay.h 中判断一点是否在三角形内部
 	T norm2() const
 	{
 		return x * x + y * y;
@@ -41,7 +41,7 @@ public:
 	T y;
 };
 
-//ȫػ
+//全特化
 template <>
 float Vector2<float>::dist(const Vector2<float>& v) const { return hypotf(x - v.x, y - v.y); }
 
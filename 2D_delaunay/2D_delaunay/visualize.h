@@ -10,15 +10,15 @@
 
 class Visualizer {
 public:
-    // ӻ
+    // 可视化函数
     static void visualizePointsAndEdges(const std::vector<Vector2<float>>& points,
         const std::vector<Edge<float>>& edges,
         const std::string& windowTitle) {
 
-        // 
+        // 创建窗口
         sf::RenderWindow window(sf::VideoMode(800, 600), windowTitle);
 
-        // ״
+        // 创建点形状
         std::vector<sf::RectangleShape*> squares;
         for (const auto& p : points) {
             sf::RectangleShape* c1 = new sf::RectangleShape(sf::Vector2f(4, 4));
@@ -27,7 +27,7 @@ public:
             squares.push_back(c1);
         }
 
-        // ״
+        // 创建边形状
         std::vector<std::vector<sf::Vertex>> lines;
         for (const auto& e : edges) {
             std::vector<sf::Vertex> line = {
@@ -37,9 +37,9 @@ public:
             lines.push_back(line);
         }
 
-        std::cout << "ӻ: " << points.size() << " , " << edges.size() << " " << std::endl;
+        std::cout << "可视化: " << points.size() << " 个点, " << edges.size() << " 条边" << std::endl;
 
-        // ѭ
+        // 主循环
         while (window.isOpen()) {
             sf::Event event;
             while (window.pollEvent(event)) {
@@ -50,14 +50,14 @@ public:
 
             window.clear(sf::Color::White);
 
-            // Ʊ
+            // 绘制边
             for (const auto& line : lines) {
                 if (line.size() >= 2) {
                     window.draw(&line[0], line.size(), sf::Lines);
                 }
             }
 
-            // Ƶ
+            // 绘制点
             for (const auto& s : squares) {
                 window.draw(*s);
             }
@@ -65,7 +65,7 @@ public:
             window.display();
         }
 
-        // ڴ
+        // 清理内存
         for (auto& square : squares) {
             delete square;
         }
@@ -11,6 +11,8 @@
 #include <CGAL/Alpha_shape_vertex_base_3.h>
 #include <CGAL/Delaunay_triangulation_3.h>
 
+#include "text_parser.h"
+
 // 使用CGAL内核和点类型
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef K::Point_3 Point_3;
@@ -85,35 +87,26 @@ std::string getFilePathFromUser() {
 
 std::vector<Point_3> readPDB(const std::string& filename) {
     std::vector<Point_3> points;
-    std::ifstream file(filename);
 
-    if (!file.is_open()) {
+    // ATOM / HETATM 记录的 x、y、z 位于固定的第 31-38、39-46、47-54 列，直接在读入的缓冲区上按列解析
+    const bool opened = textparse::parseLines(filename, points,
+        [](const char* line, const char* end, std::vector<Point_3>& out) {
+            if (!textparse::startsWith(line, end, "ATOM") && !textparse::startsWith(line, end, "HETATM")) {
+                return;
+            }
+            double x, y, z;
+            if (textparse::parseField(line, end, 30, 8, x) && textparse::parseField(line, end, 38, 8, y)
+                && textparse::parseField(line, end, 46, 8, z)) {
+                out.push_back(Point_3(x, y, z));
+            }
+        });
+
+    if (!opened) {
         std::cerr << "错误: 无法打开文件: " << filename << std::endl;
         return points;
     }
 
-    std::string line;
-    int count = 0;
-
-    while (std::getline(file, line)) {
-        if (line.substr(0, 4) == "ATOM" || line.substr(0, 6) == "HETATM") {
-            if (line.length() >= 54) {
-                try {
-                    double x = std::stod(line.substr(30, 8));
-                    double y = std::stod(line.substr(38, 8));
-                    double z = std::stod(line.substr(46, 8));
-                    points.push_back(Point_3(x, y, z));
-                    count++;
-                }
-                catch (...) {
-                    // 忽略解析错误
-                }
-            }
-        }
-    }
-
-    file.close();
-    std::cout << "成功解析原子数: " << count << std::endl;
+    std::cout << "成功解析原子数: " << points.size() << std::endl;
     return points;
 }
 
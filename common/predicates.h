@@ -0,0 +1,257 @@
+﻿#pragma once
+#ifndef H_PREDICATES
+#define H_PREDICATES
+
+#include <cmath>
+#include <cstdlib>
+
+// 鲁棒几何谓词（参考 Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates"）。先用普通浮点计算并估计舍入误差上界，结果的符号可以确定时直接返回；
+// 只有结果落在误差范围内（接近共线、共圆）时才改用无误差展开（expansion）精确计算。
+// 要求按 IEEE 754 双精度、就近舍入计算，不能开启 /fp:fast 或 -ffast-math。
+namespace predicates {
+
+    namespace detail {
+
+        // 机器精度的一半 2^-53 及各谓词的误差界系数
+        const double epsilon = 1.1102230246251565e-16;
+        const double splitter = 134217729.0; // 2^27 + 1
+        const double ccwErrBoundA = (3.0 + 16.0 * epsilon) * epsilon;
+        const double iccErrBoundA = (10.0 + 96.0 * epsilon) * epsilon;
+
+        // x + y == a + b 精确成立，要求 |a| >= |b|
+        inline void fastTwoSum(double a, double b, double& x, double& y)
+        {
+            x = a + b;
+            const double bvirt = x - a;
+            y = b - bvirt;
+        }
+
+        // x + y == a + b 精确成立
+        inline void twoSum(double a, double b, double& x, double& y)
+        {
+            x = a + b;
+            const double bvirt = x - a;
+            const double avirt = x - bvirt;
+            const double bround = b - bvirt;
+            const double around = a - avirt;
+            y = around + bround;
+        }
+
+        // x + y == a * b 精确成立
+        inline void twoProduct(double a, double b, double& x, double& y)
+        {
+            x = a * b;
+#ifdef FP_FAST_FMA
+            y = std::fma(a, b, -x);
+#else
+            double c = splitter * a;
+            const double ahi = c - (c - a);
+            const double alo = a - ahi;
+            c = splitter * b;
+            const double bhi = c - (c - b);
+            const double blo = b - bhi;
+            const double err1 = x - ahi * bhi;
+            const double err2 = err1 - alo * bhi;
+            const double err3 = err2 - ahi * blo;
+            y = alo * blo - err3;
+#endif
+        }
+
+        // 两个展开式求和（结果去掉零分量），返回 h 的长度
+        inline int expansionSum(int elen, const double* e, int flen, const double* f, double* h)
+        {
+            double Q, Qnew, hh;
+            int eindex = 0, findex = 0, hindex = 0;
+            double enow = e[0];
+            double fnow = f[0];
+
+            if ((fnow > enow) == (fnow > -enow)) { Q = enow; enow = ++eindex < elen ? e[eindex] : 0; }
+            else { Q = fnow; fnow = ++findex < flen ? f[findex] : 0; }
+
+            if (eindex < elen && findex < flen)
+            {
+                if ((fnow > enow) == (fnow > -enow)) { fastTwoSum(enow, Q, Qnew, hh); enow = ++eindex < elen ? e[eindex] : 0; }
+                else { fastTwoSum(fnow, Q, Qnew, hh); fnow = ++findex < flen ? f[findex] : 0; }
+                Q = Qnew;
+                if (hh != 0.0) h[hindex++] = hh;
+
+                while (eindex < elen && findex < flen)
+                {
+                    if ((fnow > enow) == (fnow > -enow)) { twoSum(Q, enow, Qnew, hh); enow = ++eindex < elen ? e[eindex] : 0; }
+                    else { twoSum(Q, fnow, Qnew, hh); fnow = ++findex < flen ? f[findex] : 0; }
+                    Q = Qnew;
+                    if (hh != 0.0) h[hindex++] = hh;
+                }
+            }
+            while (eindex < elen)
+            {
+                twoSum(Q, enow, Qnew, hh);
+                enow = ++eindex < elen ? e[eindex] : 0;
+                Q = Qnew;
+                if (hh != 0.0) h[hindex++] = hh;
+            }
+            while (findex < flen)
+            {
+                twoSum(Q, fnow, Qnew, hh);
+                fnow = ++findex < flen ? f[findex] : 0;
+                Q = Qnew;
+                if (hh != 0.0) h[hindex++] = hh;
+            }
+            if (Q != 0.0 || hindex == 0) h[hindex++] = Q;
+            return hindex;
+        }
+
+        // 展开式乘以一个浮点数（结果去掉零分量），返回 h 的长度
+        inline int scaleExpansion(int elen, const double* e, double b, double* h)
+        {
+            double Q, sum, hh, product1, product0;
+            int hindex = 0;
+
+            twoProduct(e[0], b, Q, hh);
+            if (hh != 0.0) h[hindex++] = hh;
+            for (int eindex = 1; eindex < elen; ++eindex)
+            {
+                twoProduct(e[eindex], b, product1, product0);
+                twoSum(Q, product0, sum, hh);
+                if (hh != 0.0) h[hindex++] = hh;
+                fastTwoSum(product1, sum, Q, hh);
+                if (hh != 0.0) h[hindex++] = hh;
+            }
+            if (Q != 0.0 || hindex == 0) h[hindex++] = Q;
+            return hindex;
+        }
+
+        // a1 * b1 - a2 * b2 的精确值，写成至多 4 个分量的展开式，返回分量个数
+        inline int crossTerm(double a1, double b1, double a2, double b2, double* h)
+        {
+            double p[2], q[2];
+            twoProduct(a1, b1, p[1], p[0]);
+            twoProduct(a2, b2, q[1], q[0]);
+            q[0] = -q[0];
+            q[1] = -q[1];
+            return expansionSum(2, p, 2, q, h);
+        }
+
+        // 展开式的符号由最高位分量决定
+        inline double orient2dExact(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            double aterms[4], bterms[4], cterms[4], v[8], w[12];
+            const int alen = crossTerm(ax, by, ax, cy, aterms);
+            const int blen = crossTerm(bx, cy, bx, ay, bterms);
+            const int clen = crossTerm(cx, ay, cx, by, cterms);
+            const int vlen = expansionSum(alen, aterms, blen, bterms, v);
+            const int wlen = expansionSum(vlen, v, clen, cterms, w);
+            return w[wlen - 1];
+        }
+
+        // 行列式的一项：lift(p) * det3，lift(p) = px^2 + py^2，sign 为该项的符号
+        inline int liftedTerm(int len, const double* det3, double px, double py, double sign, double* h)
+        {
+            double t24x[24], t48x[48], t24y[24], t48y[48];
+            const int xlen = scaleExpansion(len, det3, px, t24x);
+            const int xxlen = scaleExpansion(xlen, t24x, sign * px, t48x);
+            const int ylen = scaleExpansion(len, det3, py, t24y);
+            const int yylen = scaleExpansion(ylen, t24y, sign * py, t48y);
+            return expansionSum(xxlen, t48x, yylen, t48y, h);
+        }
+
+        inline double incircleExact(double ax, double ay, double bx, double by,
+            double cx, double cy, double dx, double dy)
+        {
+            double ab[4], bc[4], cd[4], da[4], ac[4], bd[4];
+            const int ablen = crossTerm(ax, by, bx, ay, ab);
+            const int bclen = crossTerm(bx, cy, cx, by, bc);
+            const int cdlen = crossTerm(cx, dy, dx, cy, cd);
+            const int dalen = crossTerm(dx, ay, ax, dy, da);
+            const int aclen = crossTerm(ax, cy, cx, ay, ac);
+            const int bdlen = crossTerm(bx, dy, dx, by, bd);
+
+            double temp8[8], abc[12], bcd[12], cda[12], dab[12];
+            int templen = expansionSum(cdlen, cd, dalen, da, temp8);
+            const int cdalen = expansionSum(templen, temp8, aclen, ac, cda);
+            templen = expansionSum(dalen, da, ablen, ab, temp8);
+            const int dablen = expansionSum(templen, temp8, bdlen, bd, dab);
+            for (int i = 0; i < bdlen; ++i) bd[i] = -bd[i];
+            for (int i = 0; i < aclen; ++i) ac[i] = -ac[i];
+            templen = expansionSum(ablen, ab, bclen, bc, temp8);
+            const int abclen = expansionSum(templen, temp8, aclen, ac, abc);
+            templen = expansionSum(bclen, bc, cdlen, cd, temp8);
+            const int bcdlen = expansionSum(templen, temp8, bdlen, bd, bcd);
+
+            double adet[96], bdet[96], cdet[96], ddet[96], abdet[192], cddet[192], deter[384];
+            const int alen = liftedTerm(bcdlen, bcd, ax, ay, 1.0, adet);
+            const int blen = liftedTerm(cdalen, cda, bx, by, -1.0, bdet);
+            const int clen = liftedTerm(dablen, dab, cx, cy, 1.0, cdet);
+            const int dlen = liftedTerm(abclen, abc, dx, dy, -1.0, ddet);
+
+            const int abdetlen = expansionSum(alen, adet, blen, bdet, abdet);
+            const int cddetlen = expansionSum(clen, cdet, dlen, ddet, cddet);
+            const int deterlen = expansionSum(abdetlen, abdet, cddetlen, cddet, deter);
+            return deter[deterlen - 1];
+        }
+    }
+
+    // 有向面积的两倍：大于 0 表示 a、b、c 逆时针，小于 0 表示顺时针，等于 0 表示三点共线（结果的符号是精确的）
+    inline double orient2d(double ax, double ay, double bx, double by, double cx, double cy)
+    {
+        const double detleft = (ax - cx) * (by - cy);
+        const double detright = (ay - cy) * (bx - cx);
+        const double det = detleft - detright;
+
+        double detsum;
+        if (detleft > 0.0)
+        {
+            if (detright <= 0.0) return det;
+            detsum = detleft + detright;
+        }
+        else if (detleft < 0.0)
+        {
+            if (detright >= 0.0) return det;
+            detsum = -detleft - detright;
+        }
+        else
+        {
+            return det;
+        }
+
+        const double errbound = detail::ccwErrBoundA * detsum;
+        if (det >= errbound || -det >= errbound) return det;
+        return detail::orient2dExact(ax, ay, bx, by, cx, cy);
+    }
+
+    // 只用快速路径判断 orient2d(a, b, c) 是否确定大于 0：返回 true 时结论一定正确，
+    // 返回 false 时结果可能是接近 0 的正数。没有分支，适合在批量循环中由编译器向量化
+    inline bool orient2dCertainlyPositive(double ax, double ay, double bx, double by, double cx, double cy)
+    {
+        const double detleft = (ax - cx) * (by - cy);
+        const double detright = (ay - cy) * (bx - cx);
+        return detleft - detright > detail::ccwErrBoundA * (std::abs(detleft) + std::abs(detright));
+    }
+
+    // 大于 0 表示 d 在逆时针三角形 abc 的外接圆内，小于 0 表示在圆外，等于 0 表示四点共圆（结果的符号是精确的）
+    inline double incircle(double ax, double ay, double bx, double by,
+        double cx, double cy, double dx, double dy)
+    {
+        const double adx = ax - dx, ady = ay - dy;
+        const double bdx = bx - dx, bdy = by - dy;
+        const double cdx = cx - dx, cdy = cy - dy;
+
+        const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        const double cdxady = cdx * ady, adxcdy = adx * cdy;
+        const double adxbdy = adx * bdy, bdxady = bdx * ady;
+        const double alift = adx * adx + ady * ady;
+        const double blift = bdx * bdx + bdy * bdy;
+        const double clift = cdx * cdx + cdy * cdy;
+
+        const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+        const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift
+            + (std::abs(cdxady) + std::abs(adxcdy)) * blift
+            + (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+        const double errbound = detail::iccErrBoundA * permanent;
+        if (det > errbound || -det > errbound) return det;
+        return detail::incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+    }
+}
+
+#endif
@@ -0,0 +1,167 @@
+﻿#pragma once
+#ifndef H_TEXT_PARSER
+#define H_TEXT_PARSER
+
+#include "thread_pool.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <charconv>
+#include <system_error>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+// 文本坐标文件的快速解析：按大块读入文件，在块内逐行扫描，用 std::from_chars 直接从缓冲区解析数字，
+// 每行不构造 string / istringstream，也不抛异常。块的缓冲区反复使用，稳定之后不再分配内存
+namespace textparse
+{
+    // 跳过空格和制表符，从 p 开始解析一个数字；成功时 p 移到数字之后。
+    // 与 istream 一样接受前导正号（from_chars 本身不接受）
+    template <class T>
+    bool parseNumber(const char*& p, const char* end, T& value)
+    {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p < end && *p == '+') ++p;
+        const std::from_chars_result r = std::from_chars(p, end, value);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+
+    // 固定列格式（如 PDB）：解析从第 column 个字符开始、宽 width 的字段，行不够长时返回 false
+    template <class T>
+    bool parseField(const char* line, const char* end, std::size_t column, std::size_t width, T& value)
+    {
+        if (static_cast<std::size_t>(end - line) < column + width) return false;
+        const char* p = line + column;
+        return parseNumber(p, line + column + width, value);
+    }
+
+    inline bool startsWith(const char* line, const char* end, const char* prefix)
+    {
+        const std::size_t n = std::strlen(prefix);
+        return static_cast<std::size_t>(end - line) >= n && std::memcmp(line, prefix, n) == 0;
+    }
+
+    // 对 [first, last) 中的每一行调用 f(lineBegin, lineEnd)，行尾的 '\r' 不计入
+    template <class F>
+    void forEachLine(const char* first, const char* last, F&& f)
+    {
+        while (first < last)
+        {
+            const char* newline = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+            const char* end = newline ? newline : last;
+            f(first, end > first && end[-1] == '\r' ? end - 1 : end);
+            first = newline ? newline + 1 : last;
+        }
+    }
+
+    // 按块读取文件，每块在最后一个换行处切断，不完整的行留到下一块开头
+    class ChunkReader
+    {
+    public:
+        explicit ChunkReader(const std::string& filename, std::size_t chunkBytes = 1u << 22)
+            : _file(filename, std::ios::binary), _chunkBytes(chunkBytes)
+        {
+        }
+
+        bool isOpen() const { return _file.is_open(); }
+        std::uint64_t bytesRead() const { return _bytesRead; }
+
+        // 把下一块（若干完整的行）读入 block，文件读完时返回 false。block 的容量会被复用
+        bool next(std::vector<char>& block)
+        {
+            std::size_t size = _tail.size();
+            block.resize(size + _chunkBytes);
+            if (size) std::memcpy(block.data(), _tail.data(), size);
+            _tail.clear();
+
+            while (true)
+            {
+                if (!_eof)
+                {
+                    _file.read(block.data() + size, static_cast<std::streamsize>(block.size() - size));
+                    const std::size_t got = static_cast<std::size_t>(_file.gcount());
+                    size += got;
+                    _bytesRead += got;
+                    if (!_file) _eof = true;
+                }
+                if (_eof)
+                {
+                    block.resize(size);
+                    return size > 0;
+                }
+
+                std::size_t cut = size;
+                while (cut > 0 && block[cut - 1] != '\n') --cut;
+                if (cut > 0)
+                {
+                    _tail.assign(block.begin() + cut, block.begin() + size);
+                    block.resize(cut);
+                    return true;
+                }
+                // 一行比整块还长，加大缓冲区继续读
+                block.resize(block.size() * 2);
+            }
+        }
+
+    private:
+        std::ifstream _file;
+        std::size_t _chunkBytes;
+        std::vector<char> _tail;
+        std::uint64_t _bytesRead = 0;
+        bool _eof = false;
+    };
+
+    // 逐行解析整个文件：parse(lineBegin, lineEnd, out) 解析一行，得到记录时追加到 out。
+    // 给出线程池时每批读入若干块，各块并行解析到自己的数组，再按文件中的顺序拼接，结果与串行相同；
+    // 此时 parse 会被多个线程同时调用，不能修改共享状态。文件无法打开时返回 false
+    template <class Item, class Parse>
+    bool parseLines(const std::string& filename, std::vector<Item>& out, Parse parse,
+        ThreadPool* pool = nullptr, std::size_t chunkBytes = 1u << 22)
+    {
+        ChunkReader reader(filename, chunkBytes);
+        if (!reader.isOpen()) return false;
+        out.clear();
+
+        if (!pool || pool->size() < 2)
+        {
+            std::vector<char> block;
+            while (reader.next(block))
+            {
+                forEachLine(block.data(), block.data() + block.size(), [&](const char* first, const char* last) {
+                    parse(first, last, out);
+                });
+            }
+            return true;
+        }
+
+        const std::size_t batch = 2 * pool->size();
+        std::vector<std::vector<char>> blocks(batch);
+        std::vector<std::vector<Item>> parsed(batch);
+        bool more = true;
+        while (more)
+        {
+            std::size_t count = 0;
+            while (count < batch && (more = reader.next(blocks[count]))) ++count;
+
+            TaskGroup group(*pool);
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                group.run([&, k] {
+                    parsed[k].clear();
+                    forEachLine(blocks[k].data(), blocks[k].data() + blocks[k].size(), [&](const char* first, const char* last) {
+                        parse(first, last, parsed[k]);
+                    });
+                });
+            }
+            group.wait();
+            for (std::size_t k = 0; k < count; ++k) out.insert(out.end(), parsed[k].begin(), parsed[k].end());
+        }
+        return true;
+    }
+}
+
+#endif
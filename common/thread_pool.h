@@ -0,0 +1,220 @@
+﻿#pragma once
+#ifndef H_THREAD_POOL
+#define H_THREAD_POOL
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <cstddef>
+
+// 工作窃取线程池：每个工作线程有自己的任务队列，从队尾取自己提交的任务（后进先出，缓存友好），
+// 自己的队列空了再从其他线程的队首窃取（先进先出，偷到的通常是较大的任务）。
+// 在任务内部等待子任务时调用方会帮忙执行任务，所以递归地提交、等待任务不会死锁
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0) threads = defaultThreadCount();
+        _queues.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) _queues.emplace_back(new Queue);
+        _workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) _workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto& w : _workers) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static unsigned defaultThreadCount()
+    {
+        const unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    unsigned size() const { return static_cast<unsigned>(_workers.size()); }
+
+    // 提交一个任务：工作线程提交到自己的队列，外部线程轮流提交到各个队列
+    void submit(Task task)
+    {
+        const std::size_t q = currentWorker() >= 0
+            ? static_cast<std::size_t>(currentWorker())
+            : _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+        {
+            std::lock_guard<std::mutex> lock(_queues[q]->mutex);
+            _queues[q]->tasks.push_back(std::move(task));
+        }
+        _queued.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wake.notify_one();
+    }
+
+    // 取出并执行一个任务（先取自己的，再去窃取），没有任务时返回 false
+    bool runPendingTask()
+    {
+        Task task;
+        if (!takeTask(task)) return false;
+        task();
+        return true;
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // 当前线程在哪个线程池中的编号，不是本线程池的工作线程时为 -1
+    int currentWorker() const
+    {
+        return workerPool() == this ? workerIndex() : -1;
+    }
+
+    static const ThreadPool*& workerPool()
+    {
+        thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static int& workerIndex()
+    {
+        thread_local int index = -1;
+        return index;
+    }
+
+    bool takeTask(Task& task)
+    {
+        if (_queued.load(std::memory_order_acquire) == 0) return false;
+
+        const int self = currentWorker();
+        const std::size_t count = _queues.size();
+        if (self >= 0)
+        {
+            Queue& own = *_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                _queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        const std::size_t start = self >= 0 ? static_cast<std::size_t>(self) + 1 : 0;
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            Queue& victim = *_queues[(start + k) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                _queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index)
+    {
+        workerPool() = this;
+        workerIndex() = static_cast<int>(index);
+        for (;;)
+        {
+            if (runPendingTask()) continue;
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wake.wait(lock, [this] { return _stopping || _queued.load(std::memory_order_acquire) > 0; });
+            if (_stopping && _queued.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::atomic<std::size_t> _queued{ 0 };
+    std::atomic<std::size_t> _nextQueue{ 0 };
+    std::mutex _sleepMutex;
+    std::condition_variable _wake;
+    bool _stopping = false;
+};
+
+// 一组任务：run 提交，wait 等待全部完成。等待期间调用线程也执行池中的任务；
+// 任务抛出的第一个异常在 wait 中重新抛出
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool) : _pool(pool) {}
+
+    ~TaskGroup()
+    {
+        while (_remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!_pool.runPendingTask()) std::this_thread::yield();
+        }
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <class F>
+    void run(F&& f)
+    {
+        _remaining.fetch_add(1, std::memory_order_relaxed);
+        _pool.submit([this, f = std::forward<F>(f)]() mutable {
+            try
+            {
+                f();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                if (!_error) _error = std::current_exception();
+            }
+            _remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait()
+    {
+        while (_remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!_pool.runPendingTask()) std::this_thread::yield();
+        }
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(_errorMutex);
+            std::swap(error, _error);
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    ThreadPool& _pool;
+    std::atomic<std::size_t> _remaining{ 0 };
+    std::mutex _errorMutex;
+    std::exception_ptr _error;
+};
+
+#endif